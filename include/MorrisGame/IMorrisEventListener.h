@@ -1,11 +1,35 @@
 #pragma once
 
+#include "MorrisDrawRules.h"
 #include "MorrisGameState.h"
 #include "MorrisMarker.h"
 #include "MorrisPlayer.h"
+#include <cstdint>
 
 namespace Morris
 {
+	enum class MorrisEventKind
+	{
+		PlayerTurnChanged = 0,
+		GamestateChanged,
+		PlayerWin,
+		MarkerEliminated,
+		MarkerPlaced,
+		MarkerMoved,
+		MillFormed,
+		MillUnformed,
+		GameDrawn,
+		Count
+	};
+
+	using MorrisEventMask = uint32_t;
+	const MorrisEventMask MorrisAllEvents = (1u << static_cast<int>(MorrisEventKind::Count)) - 1;
+
+	inline MorrisEventMask MorrisEventBit(MorrisEventKind kind)
+	{
+		return 1u << static_cast<int>(kind);
+	}
+
 	class IMorrisEventListener
 	{
 	public:
@@ -19,5 +43,6 @@ namespace Morris
 		virtual void OnMarkerMovedCallback(int pos, const MorrisMarkerPtr marker) = 0;
 		virtual void OnMillFormed(int pos1, int pos2, int pos3, MorrisPlayer player) = 0;
 		virtual void OnMillUnFormed(int pos1, int pos2, int pos3, MorrisPlayer player) = 0;
+		virtual void OnGameDrawnCallback(MorrisDrawReason) {}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "MorrisGameState.h"
+#include "MorrisMove.h"
+#include "MorrisPosition.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace Morris
+{
+	enum class MorrisGamePhase
+	{
+		Placing = 0,
+		Moving,
+		Flying
+	};
+
+	struct MorrisReplayedMove
+	{
+		int ply = 0;
+		MorrisMove move;
+		MorrisGamePhase phase = MorrisGamePhase::Placing;	// of the player that moved, eliminations take the phase of the move that formed the mill
+		int millsFormed = 0;					// a single placement or move can close two lines
+		bool isAllInMillsElimination = false;	// every marker of the victim was part of a mill, so one had to be taken out of a mill
+	};
+
+	struct MorrisReplayedGame
+	{
+		size_t gameIndex = 0;
+		int moveCount = 0;		// moves that were replayed
+		MorrisGameState result = MorrisGameState::Playing;	// the recorded result where there is one, otherwise the state after the last move
+		bool isComplete = true;	// false if the replay stopped at an illegal move
+	};
+
+	// Collects statistics while games are replayed. Every worker thread replays its share of the games into its own reducer,
+	// the reducers are merged once all games are done.
+	class IMorrisGameReducer
+	{
+	public:
+		virtual ~IMorrisGameReducer() {}
+
+		virtual void OnGameStarted(size_t) {}
+		virtual void OnMove(const MorrisPosition&, const MorrisReplayedMove&, const MorrisPosition&) {}
+		virtual void OnGameFinished(const MorrisPosition&, const MorrisReplayedGame&) {}
+
+		virtual void Merge(const IMorrisGameReducer& other) = 0;	// other was made by the same factory
+	};
+
+	using MorrisGameReducerFactory = std::function<std::unique_ptr<IMorrisGameReducer>()>;
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "MorrisGame.h"
+#include "MorrisMove.h"
+#include <functional>
+#include <memory>
+
+namespace Morris
+{
+	class IMorrisPlayerAgent
+	{
+	public:
+		virtual ~IMorrisPlayerAgent() {}
+
+		virtual void OnGameStarted(MorrisPlayer) {}
+		virtual MorrisMove ChooseMove(const MorrisGame& game) = 0;	// called whenever it's this agent's turn, including eliminations
+	};
+
+	// every worker thread creates its own agents, so agents don't have to be thread safe
+	using MorrisPlayerAgentFactory = std::function<std::unique_ptr<IMorrisPlayerAgent>()>;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "IMorrisGameReducer.h"
+#include "MorrisMove.h"
+#include "MorrisTournament.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Morris
+{
+	struct MorrisAnalyticsConfig
+	{
+		int threadCount = 0;		// 0 uses every hardware thread
+		size_t chunkSize = 1024;	// games handed to a thread at a time
+		bool validateMoves = true;	// without validation moves must be known to be legal, replay stops at the first illegal one otherwise
+	};
+
+	// fills record with the game at gameIndex, returning false skips the game. Called concurrently from several threads.
+	using MorrisGameSource = std::function<bool(size_t gameIndex, MorrisGameRecord& record)>;
+
+	// Replays game collections on every available core through MorrisPosition, so there are no events, log messages or
+	// marker allocations, and hands every move to the reducers
+	class MorrisAnalytics
+	{
+	public:
+		MorrisAnalytics(MorrisGameReducerFactory reducerFactory, const MorrisAnalyticsConfig& config = MorrisAnalyticsConfig());
+
+		// all of them return the reducers of every thread merged into one
+		std::unique_ptr<IMorrisGameReducer> Run(const std::vector<MorrisGameRecord>& games) const;
+		std::unique_ptr<IMorrisGameReducer> Run(const std::vector<std::vector<MorrisMove>>& games) const;
+		std::unique_ptr<IMorrisGameReducer> Run(size_t gameCount, const MorrisGameSource& source) const;
+
+		// game carries the index and recorded result in and the replay outcome out
+		static void ReplayGame(const std::vector<MorrisMove>& moves, MorrisReplayedGame& game, IMorrisGameReducer& reducer, bool validateMoves = true);
+
+	private:
+		using GameReplayer = std::function<void(size_t gameIndex, IMorrisGameReducer& reducer)>;
+		std::unique_ptr<IMorrisGameReducer> RunWorkers(size_t gameCount, const GameReplayer& replayer) const;
+
+	private:
+		MorrisGameReducerFactory _reducerFactory;
+		MorrisAnalyticsConfig _config;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Morris
+{
+	// 24 bit point sets, bit n represents point n of the board
+	namespace MorrisBitboard
+	{
+		const uint32_t AllPoints = 0xFFFFFF;
+		const int SymmetryCount = 16;
+
+		extern const std::array<uint32_t, 24> AdjacentPoints;
+		extern const std::array<uint32_t, 16> Lines;
+		extern const std::array<std::array<uint32_t, 2>, 24> LinesThroughPoint;	// every point lies on exactly two lines
+
+		// point permutations that keep adjacency and lines intact: the 8 rotations and reflections of the square, each with and
+		// without swapping the outer and inner ring. Symmetries[0] is the identity.
+		extern const std::array<std::array<int, 24>, SymmetryCount> Symmetries;
+
+		inline uint32_t Bit(int pos)
+		{
+			return 1u << pos;
+		}
+
+		inline int PopCount(uint32_t points)
+		{
+			points = points - ((points >> 1) & 0x55555555u);
+			points = (points & 0x33333333u) + ((points >> 2) & 0x33333333u);
+			return static_cast<int>((((points + (points >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+		}
+
+		inline int LowestPoint(uint32_t points)
+		{
+			// de Bruijn multiplication, points must not be empty
+			static const int positions[32] =
+			{
+				0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+				31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+			};
+			return positions[((points & (~points + 1)) * 0x077CB531u) >> 27];
+		}
+
+		// true if a marker on pos completes a line with the other markers in the set
+		inline bool FormsMill(uint32_t markers, int pos)
+		{
+			markers |= Bit(pos);
+			return (markers & LinesThroughPoint[pos][0]) == LinesThroughPoint[pos][0] || (markers & LinesThroughPoint[pos][1]) == LinesThroughPoint[pos][1];
+		}
+
+		uint32_t GetMillPoints(uint32_t markers);		// points that are part of a complete line
+		uint32_t GetNeighbours(uint32_t points);		// points adjacent to any point of the set
+		uint32_t GetPointsWithFreeNeighbour(uint32_t markers, uint32_t emptyPoints);
+		uint32_t ApplySymmetry(int symmetry, uint32_t points);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "MorrisGame.h"
+#include "MorrisMove.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace Morris
+{
+	enum class MorrisCommandStatus
+	{
+		Pending = 0,
+		Applied,
+		Rejected,
+		Cancelled
+	};
+
+	class MorrisCommandToken
+	{
+	public:
+		MorrisCommandToken();
+
+		MorrisCommandStatus GetStatus() const;
+		bool IsCompleted() const;
+		MorrisCommandStatus Wait() const;	// spins until the owner thread has processed the command
+
+	private:
+		void Complete(MorrisCommandStatus status);
+
+	private:
+		std::atomic<int> _status;
+
+		friend class MorrisCommandQueue;
+	};
+
+	using MorrisCommandTokenPtr = std::shared_ptr<MorrisCommandToken>;
+	using MorrisCommandCallback = std::function<void(const MorrisMove&, MorrisCommandStatus)>;
+
+	// Front end that lets any number of threads submit moves for one game while a single owner thread applies them.
+	// Enqueue* is lock-free and safe from any thread, ProcessCommands must only be called from the thread that owns the game.
+	class MorrisCommandQueue
+	{
+	public:
+		MorrisCommandQueue(MorrisGame& game);
+		~MorrisCommandQueue();
+		MorrisCommandQueue(const MorrisCommandQueue&) = delete;
+		MorrisCommandQueue& operator=(const MorrisCommandQueue&) = delete;
+
+		MorrisCommandTokenPtr Enqueue(const MorrisMove& move, MorrisCommandCallback callback = nullptr);
+		MorrisCommandTokenPtr EnqueuePlacement(MorrisPlayer player, int pos, MorrisCommandCallback callback = nullptr);
+		MorrisCommandTokenPtr EnqueueMove(MorrisPlayer player, int from, int to, MorrisCommandCallback callback = nullptr);
+		MorrisCommandTokenPtr EnqueueElimination(MorrisPlayer player, int pos, MorrisCommandCallback callback = nullptr);
+
+		int ProcessCommands(int maxCommands = 64);	// returns the number of commands drained
+
+	private:
+		struct CommandNode
+		{
+			std::atomic<CommandNode*> next;
+			MorrisMove move;
+			MorrisCommandTokenPtr token;
+			MorrisCommandCallback callback;
+		};
+
+		void Push(CommandNode* node);
+		CommandNode* Pop();
+
+	private:
+		MorrisGame& _game;
+
+		std::atomic<CommandNode*> _head;	// producers push here
+		CommandNode* _tail;					// consumer pops here
+		CommandNode _stub;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "IMorrisEventListener.h"
+#include "MorrisGame.h"
+#include "MorrisSnapshot.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Morris
+{
+	// Records are bit packed, a 3 bit type followed by its payload. Mills are not sent, they follow from the board.
+	enum class MorrisDeltaRecordType
+	{
+		End = 0,		// rest of the packet is padding
+		Keyframe,		// full state, 60 bits
+		Place,			// point and color, 6 bits
+		Move,			// from and to, 10 bits
+		Remove,			// point, 5 bits
+		TurnChanged,	// player, 1 bit
+		StateChanged	// game state, 3 bits
+	};
+
+	struct MorrisDeltaRecord
+	{
+		MorrisDeltaRecordType type = MorrisDeltaRecordType::End;
+		MorrisPlayer player = MorrisPlayer::Player1;
+		int from = -1;
+		int to = -1;
+		MorrisGameState gameState = MorrisGameState::Playing;
+	};
+
+	// Subscribes to a game and turns its events into a compact delta stream. Call Flush after each move to get the packet to fan out.
+	class MorrisDeltaEncoder : public IMorrisEventListener
+	{
+	public:
+		MorrisDeltaEncoder(MorrisGame& game, int keyframeInterval = 64);	// keyframeInterval is in records, 0 sends only the initial keyframe
+		~MorrisDeltaEncoder();
+		MorrisDeltaEncoder(const MorrisDeltaEncoder&) = delete;
+		MorrisDeltaEncoder& operator=(const MorrisDeltaEncoder&) = delete;
+
+		void RequestKeyframe();
+		std::vector<uint8_t> Flush();
+
+		void OnPlayerTurnChangedCallback(MorrisPlayer player) override;
+		void OnGamestateChangedCallback(MorrisGameState previousGamestate, MorrisGameState currentGameState) override;
+		void OnPlayerWinCallback(MorrisPlayer) override {}
+		void OnMarkerEliminatedCallback(const MorrisMarkerPtr marker) override;
+		void OnMarkerPlacedCallback(int pos, const MorrisMarkerPtr marker) override;
+		void OnMarkerMovedCallback(int pos, const MorrisMarkerPtr marker) override;
+		void OnMillFormed(int, int, int, MorrisPlayer) override {}
+		void OnMillUnFormed(int, int, int, MorrisPlayer) override {}
+
+	private:
+		int FindMarker(const MorrisMarkerPtr& marker) const;
+		void WriteBits(uint32_t value, int bitCount);
+		void WriteKeyframe();
+
+	private:
+		MorrisGame& _game;
+		MorrisSnapshot _state;								// mirrored from the events, the game only publishes after a move completes
+		std::array<const MorrisMarker*, 24> _markers;		// which marker sits on each point, events only carry the marker
+		int _keyframeInterval;
+		int _recordsSinceKeyframe = 0;
+		bool _keyframeRequested = true;
+
+		std::vector<uint8_t> _buffer;
+		int _bitCount = 0;
+	};
+
+	// Rebuilds the game state from packets produced by MorrisDeltaEncoder. Deltas received before the first keyframe are skipped.
+	class MorrisDeltaDecoder
+	{
+	public:
+		MorrisDeltaDecoder();
+
+		int Decode(const uint8_t* data, size_t size);	// returns the number of records applied
+		int Decode(const std::vector<uint8_t>& packet);
+		void SetRecordCallback(std::function<void(const MorrisDeltaRecord&)> recordCallback);
+
+		bool IsSynchronized() const;
+		const MorrisSnapshot& GetState() const;
+		uint32_t GetMillPoints(MorrisPlayer player) const;
+
+	private:
+		void Apply(const MorrisDeltaRecord& record);
+
+	private:
+		MorrisSnapshot _state;
+		bool _isSynchronized = false;
+		std::function<void(const MorrisDeltaRecord&)> m_recordCallback;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace Morris
+{
+	enum class MorrisDrawReason
+	{
+		Repetition = 0,
+		MoveLimit
+	};
+
+	// Both rules are disabled when set to 0
+	struct MorrisDrawRules
+	{
+		int repetitionLimit = 0;		// draw when the same position occurs this many times, 3 for threefold repetition
+		int movesWithoutMillLimit = 0;	// draw after this many marker moves in a row without forming a mill
+	};
+}
\ No newline at end of file
@@ -1,9 +1,10 @@
 #pragma once
 
+#include "MorrisBitboard.h"
 #include "MorrisMarker.h"
 #include <array>
+#include <cstdint>
 #include <functional>
-#include <set>
 #include <vector>
 
 namespace Morris
@@ -29,6 +30,9 @@ namespace Morris
 		bool JumpMarkerTo(int pos, const MorrisMarkerPtr marker);
 		bool EliminateMarker(const MorrisMarkerPtr marker);
 		int GetMarkerCount(MorrisPlayer player) const;
+		uint32_t GetMarkerMask(MorrisPlayer player) const;
+		uint32_t GetEmptyMask() const;
+		uint32_t GetMillPointsMask(MorrisPlayer player) const;
 		bool Has3InARow(const MorrisMarkerPtr marker) const;
 		bool IsMarkerPartOfMill(const MorrisMarkerPtr marker) const;
 		const std::vector<std::array<MorrisMarkerPtr, 3>>& GetMills() const;
@@ -45,38 +49,11 @@ namespace Morris
 
 	private:
 		std::array<MorrisMarkerPtr, 24> _cells;
+		std::array<uint32_t, 2> _markerMasks = {{ 0, 0 }};	// kept in sync with _cells, indexed by MorrisPlayer
 
 		std::function<void(int, int, int, MorrisPlayer)> m_onMillFormedCallback;
 		std::function<void(int, int, int, MorrisPlayer)> m_onMillUnormedCallback;
 
-		const std::vector<std::set<int>> _adjacents =
-		{
-			{1, 9},				// 0
-			{0, 2, 4},			// 1
-			{1, 14},			// 2
-			{4, 10},			// 3
-			{1, 3, 5, 7},		// 4
-			{4, 13},			// 5
-			{7, 11},			// 6
-			{4, 6, 8},			// 7
-			{7, 12},			// 8
-			{0, 10, 21},		// 9
-			{3, 9, 11, 18},		// 10
-			{6, 10, 15},		// 11
-			{8, 13, 17},		// 12
-			{5, 12, 14, 20},	// 13
-			{2, 13, 23},		// 14
-			{11, 16},			// 15
-			{15, 17, 19},		// 16
-			{12, 16},			// 17
-			{10, 19},			// 18
-			{16, 18, 20, 22},	// 19
-			{13, 19},			// 20
-			{9, 22},			// 21
-			{19, 21, 23},		// 22
-			{14, 22}			// 23
-		};
-
 		const std::vector<std::array<int, 3>> _lines =
 		{
 			{0, 1, 2},
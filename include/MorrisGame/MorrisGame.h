@@ -2,10 +2,16 @@
 
 #include "IMorrisEventListener.h"
 #include "IMorrisLogger.h"
+#include "MorrisDrawRules.h"
 #include "MorrisField.h"
 #include "MorrisGameState.h"
 #include "MorrisPlayer.h"
 #include "MorrisMarker.h"
+#include "MorrisMove.h"
+#include "MorrisSnapshot.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace Morris
@@ -18,24 +24,40 @@ namespace Morris
 		~MorrisGame() = default;
 		void ResetGame();
 
-		void SubscribeToEvents(IMorrisEventListener* morrisEventListener);
+		void SubscribeToEvents(IMorrisEventListener* morrisEventListener, MorrisEventMask eventMask = MorrisAllEvents);	// subscribing again replaces the mask
 		void UnsubscribeFromEvents(IMorrisEventListener* morrisEventListener);
+		void SetDrawRules(const MorrisDrawRules& drawRules);
+		const MorrisDrawRules& GetDrawRules() const;
 		MorrisGameState GetGameState() const;
 		MorrisPlayer GetCurrentPlayerTurn() const;
 		const MorrisMarkerPtr GetMarkerAt(int pos) const;
 		const std::vector<MorrisMarkerPtr>& GetUnplacedMarkers() const;
+		MorrisSnapshot GetSnapshot() const;	// safe to call from any thread, never blocks the game thread
 		
 		bool PlaceMarketAtPoint(int pos, const MorrisMarkerPtr marker);
 		bool MoveMarkerToPoint(int pos, const MorrisMarkerPtr marker);
 		bool EliminateMarker(const MorrisMarkerPtr marker);
+		bool ApplyMove(const MorrisMove& move);
 		bool CanMarkerBeEliminated(const MorrisMarkerPtr marker) const;
+
+		// bit n of the returned masks represents point n
+		uint32_t GetPlacementTargetsMask() const;
+		uint32_t GetLegalDestinationsMask(int pos) const;
+		uint32_t GetMovableMarkersMask(MorrisPlayer player) const;	// regardless of whose turn it is
+		uint32_t GetEliminableMarkersMask() const;
+		std::vector<MorrisMove> GetLegalMoves() const;	// for the player whose turn it is
+
 		void OnMillFormed(int pos1, int pos2, int pos3, MorrisPlayer player);
 		void OnMillUnformed(int pos1, int pos2, int pos3, MorrisPlayer player);
 
 	private:
 		bool CanPlayerMakeAMove(MorrisPlayer player) const;
+		int GetUnplacedMarkerCount(MorrisPlayer player) const;
 		void ChangePlayerTurn();
 		void AfterMoveLogic(const MorrisMarkerPtr& marker);
+		void PublishSnapshot();
+		void CheckDrawRules();
+		uint64_t GetPositionKey() const;
 
 	private:
 		MorrisField _gameField;
@@ -46,15 +68,37 @@ namespace Morris
 		std::vector<MorrisMarkerPtr> _placedMarkers;
 		std::vector<MorrisMarkerPtr> _eliminatedMakers;
 
+		MorrisSnapshotPublisher _snapshotPublisher;
+
+		MorrisDrawRules _drawRules;
+		std::unordered_map<uint64_t, int> _positionOccurrences;	// positions since the last placement or elimination
+		int _movesWithoutMill = 0;
+
 	private:
-		std::vector<IMorrisEventListener*> m_morrisEventListeners;
+		std::array<std::vector<IMorrisEventListener*>, static_cast<int>(MorrisEventKind::Count)> m_morrisEventListeners;	// one list per event kind
+		int m_eventDispatchDepth = 0;
+		bool m_hasRemovedEventListeners = false;
 		IMorrisLogger* m_morrisLogger = nullptr;
 
-	#define TRIGGER_EVENT(callbackMethodName, ...) \
-		for (IMorrisEventListener* listener : m_morrisEventListeners) \
-			listener->callbackMethodName(__VA_ARGS__);
+	// listeners removed during a callback are nulled out and compacted once the outermost dispatch finishes, listeners added during a callback are notified from the next event on
+	#define TRIGGER_EVENT(eventKind, callbackMethodName, ...) \
+		do \
+		{ \
+			std::vector<IMorrisEventListener*>& listeners_ = m_morrisEventListeners[static_cast<int>(MorrisEventKind::eventKind)]; \
+			++m_eventDispatchDepth; \
+			for (size_t i_ = 0, count_ = listeners_.size(); i_ < count_ && i_ < listeners_.size(); ++i_) \
+			{ \
+				if (IMorrisEventListener* listener = listeners_[i_]) \
+					listener->callbackMethodName(__VA_ARGS__); \
+			} \
+			if (--m_eventDispatchDepth == 0 && m_hasRemovedEventListeners) \
+				CompactEventListeners(); \
+		} while (false)
 
 	private:
+		void RemoveEventListener(std::vector<IMorrisEventListener*>& listeners, IMorrisEventListener* morrisEventListener);
+		void ClearEventListeners();
+		void CompactEventListeners();
 		void LogMessage(const std::string& message);
 	};
 }
\ No newline at end of file
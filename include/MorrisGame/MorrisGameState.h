@@ -8,6 +8,7 @@ namespace Morris
 		RemoveP1Marker,
 		RemoveP2Marker,
 		P1Wins,
-		P2Wins
+		P2Wins,
+		Draw
 	};
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "MorrisPlayer.h"
+
+namespace Morris
+{
+	enum class MorrisMoveType
+	{
+		Place = 0,
+		Move,
+		Eliminate
+	};
+
+	// Position based description of a single action. Place uses "to", Eliminate uses "from", Move uses both.
+	struct MorrisMove
+	{
+		MorrisMoveType type = MorrisMoveType::Place;
+		MorrisPlayer player = MorrisPlayer::Player1;
+		int from = -1;
+		int to = -1;
+
+		static MorrisMove Placement(MorrisPlayer player, int pos) { return { MorrisMoveType::Place, player, -1, pos }; }
+		static MorrisMove Movement(MorrisPlayer player, int from, int to) { return { MorrisMoveType::Move, player, from, to }; }
+		static MorrisMove Elimination(MorrisPlayer player, int pos) { return { MorrisMoveType::Eliminate, player, pos, -1 }; }
+	};
+}
\ No newline at end of file
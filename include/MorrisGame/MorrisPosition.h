@@ -0,0 +1,53 @@
+#pragma once
+
+#include "MorrisGameState.h"
+#include "MorrisMove.h"
+#include "MorrisPlayer.h"
+#include "MorrisSnapshot.h"
+#include <array>
+#include <cstdint>
+
+namespace Morris
+{
+	// Compact value type copy of a game with the same rules as MorrisGame, but without markers, events, logging or draw rules.
+	// Meant for search and bulk replay where MorrisGame's bookkeeping would dominate the cost.
+	class MorrisPosition
+	{
+	public:
+		static const int MaxMoves = 64;
+		using MoveList = std::array<MorrisMove, MaxMoves>;
+
+		MorrisPosition();	// start of a new game
+		static MorrisPosition FromSnapshot(const MorrisSnapshot& snapshot);
+		static MorrisPosition FromMasks(uint32_t player1Markers, uint32_t player2Markers, int unplacedPlayer1Markers, int unplacedPlayer2Markers, MorrisPlayer sideToMove);
+
+		uint32_t GetMarkerMask(MorrisPlayer player) const;
+		uint32_t GetEmptyMask() const;
+		int GetMarkerCount(MorrisPlayer player) const;
+		int GetUnplacedMarkerCount(MorrisPlayer player) const;
+		MorrisPlayer GetSideToMove() const;
+		MorrisGameState GetGameState() const;
+		bool IsGameOver() const;
+		uint64_t GetKey() const;	// exact, two positions share a key only if they are equal
+
+		int GenerateMoves(MoveList& moves) const;	// returns the number of legal moves for the side to move
+		bool IsLegalMove(const MorrisMove& move) const;
+		void MakeMove(const MorrisMove& move);		// move must be legal
+		bool ApplyMove(const MorrisMove& move);		// checked version of MakeMove
+
+		bool operator==(const MorrisPosition& other) const;
+
+	private:
+		bool CanPlayerMakeAMove(MorrisPlayer player) const;
+		uint32_t GetEliminableMarkersMask() const;
+		void AfterPlacementOrMove(int pos);
+		void AfterElimination();
+		static MorrisPlayer Opponent(MorrisPlayer player);
+
+	private:
+		std::array<uint32_t, 2> _markers;	// indexed by MorrisPlayer
+		std::array<uint8_t, 2> _unplaced;
+		MorrisPlayer _sideToMove = MorrisPlayer::Player1;
+		MorrisGameState _gameState = MorrisGameState::Playing;
+	};
+}
\ No newline at end of file
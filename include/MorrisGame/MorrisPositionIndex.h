@@ -0,0 +1,59 @@
+#pragma once
+
+#include "MorrisPlayer.h"
+#include "MorrisPosition.h"
+#include <cstdint>
+#include <vector>
+
+namespace Morris
+{
+	// one slice of the state space, every position in it has the same marker and unplaced counts and the same side to move
+	struct MorrisSubspace
+	{
+		int player1Markers = 0;		// markers on the board
+		int player2Markers = 0;
+		int unplacedPlayer1Markers = 0;
+		int unplacedPlayer2Markers = 0;
+		MorrisPlayer sideToMove = MorrisPlayer::Player1;
+
+		static MorrisSubspace FromPosition(const MorrisPosition& position);
+		bool operator==(const MorrisSubspace& other) const;
+	};
+
+	// Bijection between the board configurations of a subspace and 0..GetSize()-1. Player 1's markers are ranked among all 24
+	// points, player 2's among the points player 1 left empty. With symmetry reduction only one position per class of
+	// MorrisBitboard::Symmetries gets an index, positions that are symmetric to each other share it.
+	// Indices only describe the board, positions waiting for a marker to be eliminated have no index of their own.
+	class MorrisPositionIndexer
+	{
+	public:
+		MorrisPositionIndexer(const MorrisSubspace& subspace, bool useSymmetry = false);
+
+		const MorrisSubspace& GetSubspace() const;
+		bool IsSymmetryReduced() const;
+		uint64_t GetSize() const;
+
+		bool Contains(const MorrisPosition& position) const;
+		uint64_t Rank(const MorrisPosition& position) const;	// position must be in the subspace
+		MorrisPosition Unrank(uint64_t index) const;			// index must be below GetSize()
+
+		// with symmetry reduction a few indices are left unused, their positions rank to a lower index of the same class
+		bool IsCanonicalIndex(uint64_t index) const;
+
+		static uint64_t GetBinomial(int n, int k);
+
+	private:
+		uint64_t RankBoard(uint32_t player1Markers, uint32_t player2Markers) const;
+		static uint64_t RankPoints(uint32_t points);
+		static uint32_t UnrankPoints(uint64_t rank, int count);
+		static uint32_t CompressPoints(uint32_t points, uint32_t freePoints);	// renumbers points by their order among the free points
+		static uint32_t ExpandPoints(uint32_t points, uint32_t freePoints);
+
+	private:
+		MorrisSubspace _subspace;
+		bool _useSymmetry;
+		uint64_t _player2Configurations;
+		uint64_t _size;
+		std::vector<uint32_t> _player1Representatives;	// sorted, only used with symmetry reduction
+	};
+}
\ No newline at end of file
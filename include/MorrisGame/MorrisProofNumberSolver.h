@@ -0,0 +1,76 @@
+#pragma once
+
+#include "MorrisMove.h"
+#include "MorrisPlayer.h"
+#include "MorrisPosition.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace Morris
+{
+	enum class MorrisSolverResult
+	{
+		Unknown = 0,
+		Win,		// for the side to move
+		Loss
+	};
+
+	struct MorrisSolverConfig
+	{
+		uint64_t maxNodes = 10000000;
+		int timeLimitMilliseconds = 10000;		// 0 disables the time limit
+		size_t hashTableEntries = 1 << 20;		// rounded down to a power of two
+		int maxDepth = 400;
+	};
+
+	struct MorrisSolverSolution
+	{
+		MorrisSolverResult result = MorrisSolverResult::Unknown;
+		std::vector<MorrisMove> principalLine;	// winning line for the winner against the longest resistance found
+		uint64_t nodes = 0;
+	};
+
+	// Depth-first proof-number search. Repeating a position counts as a failure for the side trying to win, so proven results
+	// never rely on a cycle and stay valid under repetition draw rules. The move limit of MorrisDrawRules is not taken into account.
+	class MorrisProofNumberSolver
+	{
+	public:
+		MorrisProofNumberSolver(const MorrisSolverConfig& config = MorrisSolverConfig());
+
+		MorrisSolverSolution Solve(const MorrisPosition& position);
+
+	private:
+		struct Entry
+		{
+			uint64_t key = 0;
+			uint32_t proofNumber = 0;
+			uint32_t disproofNumber = 0;
+			uint32_t work = 0;		// 0 marks an empty entry
+		};
+
+		bool ProveWin(const MorrisPosition& root, MorrisPlayer attacker);
+		bool SearchRoot(const MorrisPosition& root);
+		void Search(const MorrisPosition& position, uint32_t proofThreshold, uint32_t disproofThreshold, int depth);
+		void GetChildNumbers(const MorrisPosition& child, int depth, uint32_t& proofNumber, uint32_t& disproofNumber) const;
+		bool IsBudgetExhausted();
+		std::vector<MorrisMove> ExtractPrincipalLine(const MorrisPosition& root);
+
+		const Entry* Lookup(uint64_t key) const;
+		void Store(uint64_t key, uint32_t proofNumber, uint32_t disproofNumber, uint64_t work);
+		size_t GetBucket(uint64_t key) const;
+		static uint64_t GetRetentionPriority(const Entry& entry);
+
+	private:
+		MorrisSolverConfig _config;
+		std::vector<Entry> _table;
+		std::unordered_set<uint64_t> _path;		// positions on the current search path
+
+		MorrisPlayer _attacker = MorrisPlayer::Player1;
+		uint64_t _nodes = 0;
+		bool _isAborted = false;
+		std::chrono::steady_clock::time_point _deadline;
+	};
+}
\ No newline at end of file
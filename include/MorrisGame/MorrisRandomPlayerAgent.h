@@ -0,0 +1,20 @@
+#pragma once
+
+#include "IMorrisPlayerAgent.h"
+#include <cstdint>
+#include <random>
+
+namespace Morris
+{
+	// Picks uniformly among legal moves, useful as a baseline opponent
+	class MorrisRandomPlayerAgent : public IMorrisPlayerAgent
+	{
+	public:
+		MorrisRandomPlayerAgent(uint32_t seed = std::random_device()());
+
+		MorrisMove ChooseMove(const MorrisGame& game) override;
+
+	private:
+		std::mt19937 _random;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "MorrisGameState.h"
+#include "MorrisPlayer.h"
+#include <atomic>
+#include <cstdint>
+
+namespace Morris
+{
+	// Compact, value-type copy of the observable game state. Bit n of a marker mask is set when point n holds a marker of that player.
+	struct MorrisSnapshot
+	{
+		uint32_t player1Markers = 0;
+		uint32_t player2Markers = 0;
+		MorrisGameState gameState = MorrisGameState::Playing;
+		MorrisPlayer currentPlayerTurn = MorrisPlayer::Player1;
+		int unplacedPlayer1Markers = 0;
+		int unplacedPlayer2Markers = 0;
+		uint32_t version = 0;	// incremented on every publish
+
+		bool IsOccupied(int pos) const;
+		bool GetColorAt(int pos, MorrisPlayer& player) const;
+		int GetMarkerCount(MorrisPlayer player) const;
+	};
+
+	// Single writer, any number of readers. Readers never block the writer, they retry if a publish happened while they were reading.
+	class MorrisSnapshotPublisher
+	{
+	public:
+		MorrisSnapshotPublisher();
+		MorrisSnapshotPublisher(const MorrisSnapshotPublisher&) = delete;
+		MorrisSnapshotPublisher& operator=(const MorrisSnapshotPublisher&) = delete;
+
+		void Publish(const MorrisSnapshot& snapshot);
+		MorrisSnapshot Read() const;
+		bool TryRead(MorrisSnapshot& snapshot) const;
+
+	private:
+		std::atomic<uint32_t> _sequence;
+		std::atomic<uint64_t> _boardWord;
+		std::atomic<uint64_t> _stateWord;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "MorrisPosition.h"
+#include "MorrisPositionIndex.h"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Morris
+{
+	struct MorrisEnumeratorConfig
+	{
+		int threadCount = 0;					// 0 uses every hardware thread
+		uint64_t chunkSize = 1 << 16;			// indices handed to a thread at a time
+		uint64_t memoryLimitBytes = 1ull << 30;	// larger tables are kept in a file of their own in spillDirectory instead
+		std::string spillDirectory = ".";
+	};
+
+	// One byte per index of a MorrisPositionIndexer, held in memory or, past the memory limit, in a file that is removed again
+	// when the table is destroyed
+	class MorrisValueTable
+	{
+	public:
+		~MorrisValueTable();
+
+		uint64_t GetSize() const;
+		bool IsSpilled() const;
+		// both return false if the spill file can't be read
+		bool Get(uint64_t index, uint8_t& value) const;
+		bool Read(uint64_t firstIndex, uint64_t count, uint8_t* values) const;	// bulk access, much faster than Get on spilled tables
+
+	private:
+		friend class MorrisStateEnumerator;
+
+		MorrisValueTable(uint64_t size);
+		bool Spill(const std::string& directory);
+		bool Write(uint64_t firstIndex, uint64_t count, const uint8_t* values);
+
+	private:
+		uint64_t _size;
+		std::vector<uint8_t> _values;
+		std::string _spillFilePath;
+		mutable std::fstream _spillFile;
+		mutable std::mutex _spillFileMutex;
+	};
+
+	// called concurrently from several threads
+	using MorrisPositionEvaluator = std::function<uint8_t(const MorrisPosition& position, uint64_t index)>;
+
+	class MorrisStateEnumerator
+	{
+	public:
+		MorrisStateEnumerator(const MorrisEnumeratorConfig& config = MorrisEnumeratorConfig());
+
+		// evaluates every position of the indexer and stores the results by index, unused indices of a symmetry reduced
+		// indexer are skipped and read as 0. Returns nullptr if the spill file can't be created or written.
+		std::unique_ptr<MorrisValueTable> Enumerate(const MorrisPositionIndexer& indexer, const MorrisPositionEvaluator& evaluator) const;
+
+	private:
+		MorrisEnumeratorConfig _config;
+	};
+}
\ No newline at end of file
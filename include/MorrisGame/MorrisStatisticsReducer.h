@@ -0,0 +1,44 @@
+#pragma once
+
+#include "IMorrisGameReducer.h"
+#include <array>
+#include <cstdint>
+
+namespace Morris
+{
+	struct MorrisGameStatistics
+	{
+		uint64_t games = 0;
+		uint64_t incompleteGames = 0;	// stopped at an illegal move
+		uint64_t player1Wins = 0;
+		uint64_t player2Wins = 0;
+		uint64_t draws = 0;
+		uint64_t unfinishedGames = 0;	// neither won nor drawn at the end of the move list
+		uint64_t plies = 0;
+
+		std::array<uint64_t, 3> millsByPhase = {{ 0, 0, 0 }};	// indexed by MorrisGamePhase
+		uint64_t eliminations = 0;
+		uint64_t allInMillsEliminations = 0;
+
+		// player 1 always places first
+		std::array<uint64_t, 24> gamesByFirstPlacement = {};
+		std::array<uint64_t, 24> player1WinsByFirstPlacement = {};
+		std::array<uint64_t, 24> player2WinsByFirstPlacement = {};
+	};
+
+	// Counts results, mills and eliminations, enough for the common reports without writing a reducer
+	class MorrisStatisticsReducer : public IMorrisGameReducer
+	{
+	public:
+		void OnGameStarted(size_t gameIndex) override;
+		void OnMove(const MorrisPosition& before, const MorrisReplayedMove& move, const MorrisPosition& after) override;
+		void OnGameFinished(const MorrisPosition& position, const MorrisReplayedGame& game) override;
+		void Merge(const IMorrisGameReducer& other) override;
+
+		const MorrisGameStatistics& GetStatistics() const;
+
+	private:
+		MorrisGameStatistics _statistics;
+		int _firstPlacement = -1;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "IMorrisEventListener.h"
+#include "IMorrisPlayerAgent.h"
+#include "MorrisDrawRules.h"
+#include "MorrisGame.h"
+#include "MorrisGameState.h"
+#include "MorrisMove.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Morris
+{
+	struct MorrisTournamentConfig
+	{
+		int threadCount = 0;			// 0 uses every hardware thread
+		int maxGames = 1000;
+		int maxPliesPerGame = 1000;		// longer games are adjudicated as a draw
+		MorrisDrawRules drawRules = { 3, 100 };
+
+		// every opening is played twice with colors swapped, an empty list starts every game from the empty board
+		std::vector<std::vector<MorrisMove>> openings;
+
+		// sequential probability ratio test of elo0 against elo1, measured for the first agent
+		bool useSprt = true;
+		double elo0 = 0.0;
+		double elo1 = 10.0;
+		double alpha = 0.05;
+		double beta = 0.05;
+
+		bool recordGames = true;
+	};
+
+	struct MorrisGameRecord
+	{
+		int gameIndex = 0;
+		int openingIndex = -1;
+		bool firstAgentIsPlayer1 = true;
+		std::vector<MorrisMove> moves;	// including the opening, replayable from a new game
+		MorrisDrawRules drawRules;
+		MorrisGameState result = MorrisGameState::Playing;
+		bool adjudicated = false;		// decided by the ply limit or by an illegal move
+	};
+
+	enum class MorrisSprtDecision
+	{
+		None = 0,
+		AcceptH0,
+		AcceptH1
+	};
+
+	// All numbers are from the first agent's point of view
+	struct MorrisTournamentResult
+	{
+		int wins = 0;
+		int losses = 0;
+		int draws = 0;
+		double score = 0.0;
+		double eloDifference = 0.0;
+		double eloErrorMargin = 0.0;	// 95% confidence
+		double llr = 0.0;
+		double llrLowerBound = 0.0;
+		double llrUpperBound = 0.0;
+		MorrisSprtDecision sprtDecision = MorrisSprtDecision::None;	// with useSprt the first decision reached, kept even if later games move llr back
+		double llrAtDecision = 0.0;
+		int gamesAtDecision = 0;
+		std::vector<MorrisGameRecord> games;	// ordered by game index
+	};
+
+	// Plays two agents against each other on every available core until the game budget is spent or the SPRT concludes
+	class MorrisTournament
+	{
+	public:
+		MorrisTournament(MorrisPlayerAgentFactory firstAgentFactory, MorrisPlayerAgentFactory secondAgentFactory, const MorrisTournamentConfig& config);
+
+		MorrisTournamentResult Run();
+
+		static std::unique_ptr<MorrisGame> ReplayGame(const MorrisGameRecord& record, IMorrisEventListener* listener = nullptr);
+		static std::vector<std::vector<MorrisMove>> GenerateOpenings(int count, int placementsPerOpening, uint32_t seed);	// random placements without mills
+
+	private:
+		MorrisGameRecord PlayGame(int gameIndex, IMorrisPlayerAgent& firstAgent, IMorrisPlayerAgent& secondAgent) const;
+		void AddGameResult(MorrisTournamentResult& result, const MorrisGameRecord& record) const;
+		void UpdateStatistics(MorrisTournamentResult& result) const;
+
+	private:
+		MorrisPlayerAgentFactory _firstAgentFactory;
+		MorrisPlayerAgentFactory _secondAgentFactory;
+		MorrisTournamentConfig _config;
+	};
+}
\ No newline at end of file
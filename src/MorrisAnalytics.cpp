@@ -0,0 +1,163 @@
+#include <MorrisAnalytics.h>
+#include <MorrisBitboard.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Morris
+{
+	namespace
+	{
+		MorrisGamePhase GetPhase(const MorrisPosition& position, MorrisPlayer player)
+		{
+			if (position.GetUnplacedMarkerCount(player) > 0)
+				return MorrisGamePhase::Placing;
+
+			return (position.GetMarkerCount(player) == 3) ? MorrisGamePhase::Flying : MorrisGamePhase::Moving;
+		}
+
+		int CountMillsThroughPoint(uint32_t markers, int pos)
+		{
+			int count = 0;
+			for (uint32_t line : MorrisBitboard::LinesThroughPoint[pos])
+			{
+				if ((markers & line) == line)
+					++count;
+			}
+			return count;
+		}
+	}
+
+	MorrisAnalytics::MorrisAnalytics(MorrisGameReducerFactory reducerFactory, const MorrisAnalyticsConfig& config) :
+		_reducerFactory(reducerFactory),
+		_config(config)
+	{
+
+	}
+
+	std::unique_ptr<IMorrisGameReducer> MorrisAnalytics::Run(const std::vector<MorrisGameRecord>& games) const
+	{
+		return RunWorkers(games.size(), [&](size_t gameIndex, IMorrisGameReducer& reducer)
+		{
+			MorrisReplayedGame game;
+			game.gameIndex = gameIndex;
+			game.result = games[gameIndex].result;
+			ReplayGame(games[gameIndex].moves, game, reducer, _config.validateMoves);
+		});
+	}
+
+	std::unique_ptr<IMorrisGameReducer> MorrisAnalytics::Run(const std::vector<std::vector<MorrisMove>>& games) const
+	{
+		return RunWorkers(games.size(), [&](size_t gameIndex, IMorrisGameReducer& reducer)
+		{
+			MorrisReplayedGame game;
+			game.gameIndex = gameIndex;
+			ReplayGame(games[gameIndex], game, reducer, _config.validateMoves);
+		});
+	}
+
+	std::unique_ptr<IMorrisGameReducer> MorrisAnalytics::Run(size_t gameCount, const MorrisGameSource& source) const
+	{
+		return RunWorkers(gameCount, [&](size_t gameIndex, IMorrisGameReducer& reducer)
+		{
+			// one record per thread, so its move list keeps its capacity from game to game
+			thread_local MorrisGameRecord record;
+			record.moves.clear();
+			record.result = MorrisGameState::Playing;
+			if (!source(gameIndex, record))
+				return;
+
+			MorrisReplayedGame game;
+			game.gameIndex = gameIndex;
+			game.result = record.result;
+			ReplayGame(record.moves, game, reducer, _config.validateMoves);
+		});
+	}
+
+	void MorrisAnalytics::ReplayGame(const std::vector<MorrisMove>& moves, MorrisReplayedGame& game, IMorrisGameReducer& reducer, bool validateMoves)
+	{
+		reducer.OnGameStarted(game.gameIndex);
+
+		MorrisPosition position;
+		MorrisGamePhase millPhase = MorrisGamePhase::Placing;
+		game.moveCount = 0;
+		game.isComplete = true;
+
+		for (const MorrisMove& move : moves)
+		{
+			if (validateMoves && !position.IsLegalMove(move))
+			{
+				game.isComplete = false;
+				break;
+			}
+
+			MorrisReplayedMove replayedMove;
+			replayedMove.ply = game.moveCount;
+			replayedMove.move = move;
+
+			MorrisPosition after = position;
+			after.MakeMove(move);
+
+			if (move.type == MorrisMoveType::Eliminate)
+			{
+				const MorrisPlayer victim = (move.player == MorrisPlayer::Player1) ? MorrisPlayer::Player2 : MorrisPlayer::Player1;
+				const uint32_t victimMarkers = position.GetMarkerMask(victim);
+				replayedMove.phase = millPhase;
+				replayedMove.isAllInMillsElimination = (victimMarkers & ~MorrisBitboard::GetMillPoints(victimMarkers)) == 0;
+			}
+			else
+			{
+				replayedMove.phase = GetPhase(position, move.player);
+				replayedMove.millsFormed = CountMillsThroughPoint(after.GetMarkerMask(move.player), move.to);
+				millPhase = replayedMove.phase;
+			}
+
+			reducer.OnMove(position, replayedMove, after);
+			position = after;
+			++game.moveCount;
+		}
+
+		if (game.result == MorrisGameState::Playing)
+			game.result = position.GetGameState();
+
+		reducer.OnGameFinished(position, game);
+	}
+
+	std::unique_ptr<IMorrisGameReducer> MorrisAnalytics::RunWorkers(size_t gameCount, const GameReplayer& replayer) const
+	{
+		int threadCount = _config.threadCount;
+		if (threadCount <= 0)
+			threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+		const size_t chunkSize = std::max<size_t>(_config.chunkSize, 1);
+		const size_t chunkCount = (gameCount + chunkSize - 1) / chunkSize;
+		threadCount = static_cast<int>(std::min<size_t>(threadCount, std::max<size_t>(chunkCount, 1)));
+
+		std::vector<std::unique_ptr<IMorrisGameReducer>> reducers;
+		for (int i = 0; i < threadCount; ++i)
+			reducers.emplace_back(_reducerFactory());
+
+		std::atomic<size_t> nextChunk(0);
+		auto worker = [&](IMorrisGameReducer& reducer)
+		{
+			for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+			{
+				const size_t lastGame = std::min(gameCount, (chunk + 1) * chunkSize);
+				for (size_t gameIndex = chunk * chunkSize; gameIndex < lastGame; ++gameIndex)
+					replayer(gameIndex, reducer);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; ++i)
+			threads.emplace_back(worker, std::ref(*reducers[i]));
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (int i = 1; i < threadCount; ++i)
+			reducers[0]->Merge(*reducers[i]);
+
+		return std::move(reducers[0]);
+	}
+}
\ No newline at end of file
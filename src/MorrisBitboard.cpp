@@ -0,0 +1,168 @@
+#include <MorrisBitboard.h>
+
+namespace Morris
+{
+	namespace MorrisBitboard
+	{
+		const std::array<uint32_t, 24> AdjacentPoints =
+		{
+			0x000202,	// 0
+			0x000015,	// 1
+			0x004002,	// 2
+			0x000410,	// 3
+			0x0000AA,	// 4
+			0x002010,	// 5
+			0x000880,	// 6
+			0x000150,	// 7
+			0x001080,	// 8
+			0x200401,	// 9
+			0x040A08,	// 10
+			0x008440,	// 11
+			0x022100,	// 12
+			0x105020,	// 13
+			0x802004,	// 14
+			0x010800,	// 15
+			0x0A8000,	// 16
+			0x011000,	// 17
+			0x080400,	// 18
+			0x550000,	// 19
+			0x082000,	// 20
+			0x400200,	// 21
+			0xA80000,	// 22
+			0x404000,	// 23
+		};
+
+		const std::array<uint32_t, 16> Lines =
+		{
+			0x000007,	// 0 1 2
+			0x000038,	// 3 4 5
+			0x0001C0,	// 6 7 8
+			0x000E00,	// 9 10 11
+			0x007000,	// 12 13 14
+			0x038000,	// 15 16 17
+			0x1C0000,	// 18 19 20
+			0xE00000,	// 21 22 23
+			0x200201,	// 0 9 21
+			0x040408,	// 3 10 18
+			0x008840,	// 6 11 15
+			0x000092,	// 1 4 7
+			0x490000,	// 16 19 22
+			0x021100,	// 8 12 17
+			0x102020,	// 5 13 20
+			0x804004,	// 2 14 23
+		};
+
+		const std::array<std::array<uint32_t, 2>, 24> LinesThroughPoint =
+		{{
+			{ 0x000007, 0x200201 },	// 0
+			{ 0x000007, 0x000092 },	// 1
+			{ 0x000007, 0x804004 },	// 2
+			{ 0x000038, 0x040408 },	// 3
+			{ 0x000038, 0x000092 },	// 4
+			{ 0x000038, 0x102020 },	// 5
+			{ 0x0001C0, 0x008840 },	// 6
+			{ 0x0001C0, 0x000092 },	// 7
+			{ 0x0001C0, 0x021100 },	// 8
+			{ 0x000E00, 0x200201 },	// 9
+			{ 0x000E00, 0x040408 },	// 10
+			{ 0x000E00, 0x008840 },	// 11
+			{ 0x007000, 0x021100 },	// 12
+			{ 0x007000, 0x102020 },	// 13
+			{ 0x007000, 0x804004 },	// 14
+			{ 0x038000, 0x008840 },	// 15
+			{ 0x038000, 0x490000 },	// 16
+			{ 0x038000, 0x021100 },	// 17
+			{ 0x1C0000, 0x040408 },	// 18
+			{ 0x1C0000, 0x490000 },	// 19
+			{ 0x1C0000, 0x102020 },	// 20
+			{ 0xE00000, 0x200201 },	// 21
+			{ 0xE00000, 0x490000 },	// 22
+			{ 0xE00000, 0x804004 },	// 23
+		}};
+
+		const std::array<std::array<int, 24>, SymmetryCount> Symmetries =
+		{{
+			{{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23 }},	// identity
+			{{  2, 14, 23,  5, 13, 20,  8, 12, 17,  1,  4,  7, 16, 19, 22,  6, 11, 15,  3, 10, 18,  0,  9, 21 }},	// rotations
+			{{ 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1,  0 }},
+			{{ 21,  9,  0, 18, 10,  3, 15, 11,  6, 22, 19, 16,  7,  4,  1, 17, 12,  8, 20, 13,  5, 23, 14,  2 }},
+			{{  2,  1,  0,  5,  4,  3,  8,  7,  6, 14, 13, 12, 11, 10,  9, 17, 16, 15, 20, 19, 18, 23, 22, 21 }},	// reflections
+			{{  0,  9, 21,  3, 10, 18,  6, 11, 15,  1,  4,  7, 16, 19, 22,  8, 12, 17,  5, 13, 20,  2, 14, 23 }},
+			{{ 21, 22, 23, 18, 19, 20, 15, 16, 17,  9, 10, 11, 12, 13, 14,  6,  7,  8,  3,  4,  5,  0,  1,  2 }},
+			{{ 23, 14,  2, 20, 13,  5, 17, 12,  8, 22, 19, 16,  7,  4,  1, 15, 11,  6, 18, 10,  3, 21,  9,  0 }},
+			{{  6,  7,  8,  3,  4,  5,  0,  1,  2, 11, 10,  9, 14, 13, 12, 21, 22, 23, 18, 19, 20, 15, 16, 17 }},	// ring swap combined with the above
+			{{  8, 12, 17,  5, 13, 20,  2, 14, 23,  7,  4,  1, 22, 19, 16,  0,  9, 21,  3, 10, 18,  6, 11, 15 }},
+			{{ 17, 16, 15, 20, 19, 18, 23, 22, 21, 12, 13, 14,  9, 10, 11,  2,  1,  0,  5,  4,  3,  8,  7,  6 }},
+			{{ 15, 11,  6, 18, 10,  3, 21,  9,  0, 16, 19, 22,  1,  4,  7, 23, 14,  2, 20, 13,  5, 17, 12,  8 }},
+			{{  8,  7,  6,  5,  4,  3,  2,  1,  0, 12, 13, 14,  9, 10, 11, 23, 22, 21, 20, 19, 18, 17, 16, 15 }},
+			{{  6, 11, 15,  3, 10, 18,  0,  9, 21,  7,  4,  1, 22, 19, 16,  2, 14, 23,  5, 13, 20,  8, 12, 17 }},
+			{{ 15, 16, 17, 18, 19, 20, 21, 22, 23, 11, 10,  9, 14, 13, 12,  0,  1,  2,  3,  4,  5,  6,  7,  8 }},
+			{{ 17, 12,  8, 20, 13,  5, 23, 14,  2, 16, 19, 22,  1,  4,  7, 21,  9,  0, 18, 10,  3, 15, 11,  6 }},
+		}};
+
+		uint32_t GetMillPoints(uint32_t markers)
+		{
+			uint32_t millPoints = 0;
+			for (uint32_t line : Lines)
+			{
+				if ((markers & line) == line)
+					millPoints |= line;
+			}
+			return millPoints;
+		}
+
+		uint32_t GetNeighbours(uint32_t points)
+		{
+			uint32_t neighbours = 0;
+			for (; points; points &= points - 1)
+				neighbours |= AdjacentPoints[LowestPoint(points)];
+
+			return neighbours;
+		}
+
+		uint32_t GetPointsWithFreeNeighbour(uint32_t markers, uint32_t emptyPoints)
+		{
+			uint32_t result = 0;
+			for (uint32_t remaining = markers; remaining; remaining &= remaining - 1)
+			{
+				const int pos = LowestPoint(remaining);
+				if (AdjacentPoints[pos] & emptyPoints)
+					result |= Bit(pos);
+			}
+			return result;
+		}
+
+		uint32_t ApplySymmetry(int symmetry, uint32_t points)
+		{
+			// images of every possible byte of the mask, so a mask takes three lookups
+			struct ByteImages
+			{
+				ByteImages()
+				{
+					for (int symmetry = 0; symmetry < SymmetryCount; ++symmetry)
+					{
+						for (int byte = 0; byte < 3; ++byte)
+						{
+							for (uint32_t value = 0; value < 256; ++value)
+							{
+								uint32_t image = 0;
+								for (int bit = 0; bit < 8; ++bit)
+								{
+									if (value & Bit(bit))
+										image |= Bit(Symmetries[symmetry][byte * 8 + bit]);
+								}
+								images[symmetry][byte][value] = image;
+							}
+						}
+					}
+				}
+
+				uint32_t images[SymmetryCount][3][256];
+			};
+
+			static const ByteImages byteImages;
+			const auto& images = byteImages.images[symmetry];
+			return images[0][points & 0xFF] | images[1][(points >> 8) & 0xFF] | images[2][(points >> 16) & 0xFF];
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <MorrisCommandQueue.h>
+#include <thread>
+
+namespace Morris
+{
+	MorrisCommandToken::MorrisCommandToken() :
+		_status(static_cast<int>(MorrisCommandStatus::Pending))
+	{
+
+	}
+
+	MorrisCommandStatus MorrisCommandToken::GetStatus() const
+	{
+		return static_cast<MorrisCommandStatus>(_status.load(std::memory_order_acquire));
+	}
+
+	bool MorrisCommandToken::IsCompleted() const
+	{
+		return GetStatus() != MorrisCommandStatus::Pending;
+	}
+
+	MorrisCommandStatus MorrisCommandToken::Wait() const
+	{
+		MorrisCommandStatus status;
+		while ((status = GetStatus()) == MorrisCommandStatus::Pending)
+			std::this_thread::yield();
+
+		return status;
+	}
+
+	void MorrisCommandToken::Complete(MorrisCommandStatus status)
+	{
+		_status.store(static_cast<int>(status), std::memory_order_release);
+	}
+
+	MorrisCommandQueue::MorrisCommandQueue(MorrisGame& game) :
+		_game(game),
+		_head(&_stub),
+		_tail(&_stub)
+	{
+		_stub.next.store(nullptr, std::memory_order_relaxed);
+	}
+
+	MorrisCommandQueue::~MorrisCommandQueue()
+	{
+		// commands that were never processed are reported as cancelled
+		while (CommandNode* node = Pop())
+		{
+			node->token->Complete(MorrisCommandStatus::Cancelled);
+			if (node->callback)
+				node->callback(node->move, MorrisCommandStatus::Cancelled);
+			delete node;
+		}
+	}
+
+	MorrisCommandTokenPtr MorrisCommandQueue::Enqueue(const MorrisMove& move, MorrisCommandCallback callback)
+	{
+		CommandNode* node = new CommandNode();
+		node->move = move;
+		node->token = std::make_shared<MorrisCommandToken>();
+		node->callback = std::move(callback);
+
+		MorrisCommandTokenPtr token = node->token;
+		Push(node);
+		return token;
+	}
+
+	MorrisCommandTokenPtr MorrisCommandQueue::EnqueuePlacement(MorrisPlayer player, int pos, MorrisCommandCallback callback)
+	{
+		return Enqueue(MorrisMove::Placement(player, pos), std::move(callback));
+	}
+
+	MorrisCommandTokenPtr MorrisCommandQueue::EnqueueMove(MorrisPlayer player, int from, int to, MorrisCommandCallback callback)
+	{
+		return Enqueue(MorrisMove::Movement(player, from, to), std::move(callback));
+	}
+
+	MorrisCommandTokenPtr MorrisCommandQueue::EnqueueElimination(MorrisPlayer player, int pos, MorrisCommandCallback callback)
+	{
+		return Enqueue(MorrisMove::Elimination(player, pos), std::move(callback));
+	}
+
+	int MorrisCommandQueue::ProcessCommands(int maxCommands)
+	{
+		int processed = 0;
+		while (processed < maxCommands)
+		{
+			CommandNode* node = Pop();
+			if (!node)
+				break;
+
+			const MorrisCommandStatus status = _game.ApplyMove(node->move) ? MorrisCommandStatus::Applied : MorrisCommandStatus::Rejected;
+			node->token->Complete(status);
+			if (node->callback)
+				node->callback(node->move, status);
+
+			delete node;
+			++processed;
+		}
+		return processed;
+	}
+
+	void MorrisCommandQueue::Push(CommandNode* node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		CommandNode* prev = _head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	MorrisCommandQueue::CommandNode* MorrisCommandQueue::Pop()
+	{
+		CommandNode* tail = _tail;
+		CommandNode* next = tail->next.load(std::memory_order_acquire);
+
+		// skip over the stub node
+		if (tail == &_stub)
+		{
+			if (!next)
+				return nullptr;
+
+			_tail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+
+		if (next)
+		{
+			_tail = next;
+			return tail;
+		}
+
+		// a producer swapped the head but hasn't linked its node yet, try again on the next drain
+		if (tail != _head.load(std::memory_order_acquire))
+			return nullptr;
+
+		// tail is the last node, put the stub behind it so it can be detached
+		Push(&_stub);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next)
+		{
+			_tail = next;
+			return tail;
+		}
+		return nullptr;
+	}
+}
\ No newline at end of file
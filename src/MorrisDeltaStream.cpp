@@ -0,0 +1,345 @@
+#include <MorrisDeltaStream.h>
+#include <MorrisBitboard.h>
+#include <algorithm>
+
+namespace Morris
+{
+	namespace
+	{
+		const int RecordTypeBits = 3;
+		const int PointBits = 5;
+
+		class BitReader
+		{
+		public:
+			BitReader(const uint8_t* data, size_t size) :
+				_data(data),
+				_bitsLeft(size * 8)
+			{
+
+			}
+
+			bool CanRead(size_t bitCount) const
+			{
+				return _bitsLeft >= bitCount;
+			}
+
+			uint32_t Read(int bitCount)
+			{
+				uint32_t value = 0;
+				for (int written = 0; written < bitCount;)
+				{
+					const int offset = static_cast<int>(_position % 8);
+					const int chunk = std::min(8 - offset, bitCount - written);
+					const uint32_t bits = (_data[_position / 8] >> offset) & ((1u << chunk) - 1);
+					value |= bits << written;
+					written += chunk;
+					_position += chunk;
+					_bitsLeft -= chunk;
+				}
+				return value;
+			}
+
+		private:
+			const uint8_t* _data;
+			size_t _position = 0;
+			size_t _bitsLeft;
+		};
+
+		size_t GetPayloadBits(MorrisDeltaRecordType type)
+		{
+			switch (type)
+			{
+				case MorrisDeltaRecordType::Keyframe:		return 24 + 24 + 3 + 1 + 4 + 4;
+				case MorrisDeltaRecordType::Place:			return PointBits + 1;
+				case MorrisDeltaRecordType::Move:			return PointBits * 2;
+				case MorrisDeltaRecordType::Remove:			return PointBits;
+				case MorrisDeltaRecordType::TurnChanged:	return 1;
+				case MorrisDeltaRecordType::StateChanged:	return 3;
+				default:									return 0;
+			}
+		}
+	}
+
+	MorrisDeltaEncoder::MorrisDeltaEncoder(MorrisGame& game, int keyframeInterval) :
+		_game(game),
+		_state(game.GetSnapshot()),
+		_keyframeInterval(keyframeInterval)
+	{
+		for (int i = 0; i < 24; ++i)
+			_markers[i] = game.GetMarkerAt(i).get();
+
+		const MorrisEventMask eventMask = MorrisEventBit(MorrisEventKind::PlayerTurnChanged)
+			| MorrisEventBit(MorrisEventKind::GamestateChanged)
+			| MorrisEventBit(MorrisEventKind::MarkerEliminated)
+			| MorrisEventBit(MorrisEventKind::MarkerPlaced)
+			| MorrisEventBit(MorrisEventKind::MarkerMoved);
+		_game.SubscribeToEvents(this, eventMask);
+	}
+
+	MorrisDeltaEncoder::~MorrisDeltaEncoder()
+	{
+		_game.UnsubscribeFromEvents(this);
+	}
+
+	void MorrisDeltaEncoder::RequestKeyframe()
+	{
+		_keyframeRequested = true;
+	}
+
+	std::vector<uint8_t> MorrisDeltaEncoder::Flush()
+	{
+		if (_keyframeRequested || (_keyframeInterval > 0 && _recordsSinceKeyframe >= _keyframeInterval))
+			WriteKeyframe();
+
+		// zero padding decodes as an End record
+		std::vector<uint8_t> packet;
+		packet.swap(_buffer);
+		_bitCount = 0;
+		return packet;
+	}
+
+	void MorrisDeltaEncoder::OnPlayerTurnChangedCallback(MorrisPlayer player)
+	{
+		_state.currentPlayerTurn = player;
+		WriteBits(static_cast<uint32_t>(MorrisDeltaRecordType::TurnChanged), RecordTypeBits);
+		WriteBits(static_cast<uint32_t>(player), 1);
+		++_recordsSinceKeyframe;
+	}
+
+	void MorrisDeltaEncoder::OnGamestateChangedCallback(MorrisGameState, MorrisGameState currentGameState)
+	{
+		_state.gameState = currentGameState;
+		WriteBits(static_cast<uint32_t>(MorrisDeltaRecordType::StateChanged), RecordTypeBits);
+		WriteBits(static_cast<uint32_t>(currentGameState), 3);
+		++_recordsSinceKeyframe;
+	}
+
+	void MorrisDeltaEncoder::OnMarkerEliminatedCallback(const MorrisMarkerPtr marker)
+	{
+		const int pos = FindMarker(marker);
+		if (pos < 0)
+			return;
+
+		_markers[pos] = nullptr;
+		_state.player1Markers &= ~MorrisBitboard::Bit(pos);
+		_state.player2Markers &= ~MorrisBitboard::Bit(pos);
+		WriteBits(static_cast<uint32_t>(MorrisDeltaRecordType::Remove), RecordTypeBits);
+		WriteBits(static_cast<uint32_t>(pos), PointBits);
+		++_recordsSinceKeyframe;
+	}
+
+	void MorrisDeltaEncoder::OnMarkerPlacedCallback(int pos, const MorrisMarkerPtr marker)
+	{
+		const MorrisPlayer color = marker->GetColor();
+		_markers[pos] = marker.get();
+		if (color == MorrisPlayer::Player1)
+		{
+			_state.player1Markers |= MorrisBitboard::Bit(pos);
+			--_state.unplacedPlayer1Markers;
+		}
+		else
+		{
+			_state.player2Markers |= MorrisBitboard::Bit(pos);
+			--_state.unplacedPlayer2Markers;
+		}
+
+		WriteBits(static_cast<uint32_t>(MorrisDeltaRecordType::Place), RecordTypeBits);
+		WriteBits(static_cast<uint32_t>(pos), PointBits);
+		WriteBits(static_cast<uint32_t>(color), 1);
+		++_recordsSinceKeyframe;
+	}
+
+	void MorrisDeltaEncoder::OnMarkerMovedCallback(int pos, const MorrisMarkerPtr marker)
+	{
+		const int from = FindMarker(marker);
+		if (from < 0)
+			return;
+
+		_markers[from] = nullptr;
+		_markers[pos] = marker.get();
+		if (marker->GetColor() == MorrisPlayer::Player1)
+			_state.player1Markers ^= MorrisBitboard::Bit(from) | MorrisBitboard::Bit(pos);
+		else
+			_state.player2Markers ^= MorrisBitboard::Bit(from) | MorrisBitboard::Bit(pos);
+
+		WriteBits(static_cast<uint32_t>(MorrisDeltaRecordType::Move), RecordTypeBits);
+		WriteBits(static_cast<uint32_t>(from), PointBits);
+		WriteBits(static_cast<uint32_t>(pos), PointBits);
+		++_recordsSinceKeyframe;
+	}
+
+	int MorrisDeltaEncoder::FindMarker(const MorrisMarkerPtr& marker) const
+	{
+		for (int i = 0; i < 24; ++i)
+		{
+			if (_markers[i] == marker.get())
+				return i;
+		}
+		return -1;
+	}
+
+	void MorrisDeltaEncoder::WriteBits(uint32_t value, int bitCount)
+	{
+		while (bitCount > 0)
+		{
+			const int offset = _bitCount % 8;
+			if (offset == 0)
+				_buffer.push_back(0);
+
+			const int chunk = std::min(8 - offset, bitCount);
+			_buffer.back() |= static_cast<uint8_t>((value & ((1u << chunk) - 1)) << offset);
+			value >>= chunk;
+			bitCount -= chunk;
+			_bitCount += chunk;
+		}
+	}
+
+	void MorrisDeltaEncoder::WriteKeyframe()
+	{
+		WriteBits(static_cast<uint32_t>(MorrisDeltaRecordType::Keyframe), RecordTypeBits);
+		WriteBits(_state.player1Markers, 24);
+		WriteBits(_state.player2Markers, 24);
+		WriteBits(static_cast<uint32_t>(_state.gameState), 3);
+		WriteBits(static_cast<uint32_t>(_state.currentPlayerTurn), 1);
+		WriteBits(static_cast<uint32_t>(_state.unplacedPlayer1Markers), 4);
+		WriteBits(static_cast<uint32_t>(_state.unplacedPlayer2Markers), 4);
+		_recordsSinceKeyframe = 0;
+		_keyframeRequested = false;
+	}
+
+	MorrisDeltaDecoder::MorrisDeltaDecoder()
+	{
+
+	}
+
+	int MorrisDeltaDecoder::Decode(const uint8_t* data, size_t size)
+	{
+		BitReader reader(data, size);
+		int appliedCount = 0;
+
+		while (reader.CanRead(RecordTypeBits))
+		{
+			MorrisDeltaRecord record;
+			record.type = static_cast<MorrisDeltaRecordType>(reader.Read(RecordTypeBits));
+			if (record.type == MorrisDeltaRecordType::End || !reader.CanRead(GetPayloadBits(record.type)))
+				break;
+
+			switch (record.type)
+			{
+				case MorrisDeltaRecordType::Keyframe:
+					_state.player1Markers = reader.Read(24);
+					_state.player2Markers = reader.Read(24);
+					_state.gameState = static_cast<MorrisGameState>(reader.Read(3));
+					_state.currentPlayerTurn = static_cast<MorrisPlayer>(reader.Read(1));
+					_state.unplacedPlayer1Markers = static_cast<int>(reader.Read(4));
+					_state.unplacedPlayer2Markers = static_cast<int>(reader.Read(4));
+					_isSynchronized = true;
+					break;
+
+				case MorrisDeltaRecordType::Place:
+					record.to = static_cast<int>(reader.Read(PointBits));
+					record.player = static_cast<MorrisPlayer>(reader.Read(1));
+					break;
+
+				case MorrisDeltaRecordType::Move:
+					record.from = static_cast<int>(reader.Read(PointBits));
+					record.to = static_cast<int>(reader.Read(PointBits));
+					break;
+
+				case MorrisDeltaRecordType::Remove:
+					record.from = static_cast<int>(reader.Read(PointBits));
+					break;
+
+				case MorrisDeltaRecordType::TurnChanged:
+					record.player = static_cast<MorrisPlayer>(reader.Read(1));
+					break;
+
+				case MorrisDeltaRecordType::StateChanged:
+					record.gameState = static_cast<MorrisGameState>(reader.Read(3));
+					break;
+
+				default:	// unknown record type, the rest of the packet can't be parsed
+					return appliedCount;
+			}
+
+			if (!_isSynchronized)
+				continue;
+
+			Apply(record);
+			++appliedCount;
+		}
+		return appliedCount;
+	}
+
+	int MorrisDeltaDecoder::Decode(const std::vector<uint8_t>& packet)
+	{
+		return Decode(packet.data(), packet.size());
+	}
+
+	void MorrisDeltaDecoder::SetRecordCallback(std::function<void(const MorrisDeltaRecord&)> recordCallback)
+	{
+		m_recordCallback = recordCallback;
+	}
+
+	bool MorrisDeltaDecoder::IsSynchronized() const
+	{
+		return _isSynchronized;
+	}
+
+	const MorrisSnapshot& MorrisDeltaDecoder::GetState() const
+	{
+		return _state;
+	}
+
+	uint32_t MorrisDeltaDecoder::GetMillPoints(MorrisPlayer player) const
+	{
+		return MorrisBitboard::GetMillPoints(player == MorrisPlayer::Player1 ? _state.player1Markers : _state.player2Markers);
+	}
+
+	void MorrisDeltaDecoder::Apply(const MorrisDeltaRecord& record)
+	{
+		switch (record.type)
+		{
+			case MorrisDeltaRecordType::Place:
+				if (record.player == MorrisPlayer::Player1)
+				{
+					_state.player1Markers |= MorrisBitboard::Bit(record.to);
+					--_state.unplacedPlayer1Markers;
+				}
+				else
+				{
+					_state.player2Markers |= MorrisBitboard::Bit(record.to);
+					--_state.unplacedPlayer2Markers;
+				}
+				break;
+
+			case MorrisDeltaRecordType::Move:
+				if (_state.player1Markers & MorrisBitboard::Bit(record.from))
+					_state.player1Markers ^= MorrisBitboard::Bit(record.from) | MorrisBitboard::Bit(record.to);
+				else if (_state.player2Markers & MorrisBitboard::Bit(record.from))
+					_state.player2Markers ^= MorrisBitboard::Bit(record.from) | MorrisBitboard::Bit(record.to);
+				break;
+
+			case MorrisDeltaRecordType::Remove:
+				_state.player1Markers &= ~MorrisBitboard::Bit(record.from);
+				_state.player2Markers &= ~MorrisBitboard::Bit(record.from);
+				break;
+
+			case MorrisDeltaRecordType::TurnChanged:
+				_state.currentPlayerTurn = record.player;
+				break;
+
+			case MorrisDeltaRecordType::StateChanged:
+				_state.gameState = record.gameState;
+				break;
+
+			default:
+				break;
+		}
+
+		++_state.version;
+		if (m_recordCallback)
+			m_recordCallback(record);
+	}
+}
\ No newline at end of file
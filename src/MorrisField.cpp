@@ -44,6 +44,7 @@ namespace Morris
 			return false;
 
 		_cells[pos] = marker;
+		_markerMasks[static_cast<int>(marker->GetColor())] |= MorrisBitboard::Bit(pos);
 		AfterMoveCheckMills(_cells[pos]);
 		return true;
 	}
@@ -63,6 +64,7 @@ namespace Morris
 
 		// move and clear the previous spot
 		_cells[pos] = std::move(_cells[cpos]);
+		_markerMasks[static_cast<int>(marker->GetColor())] ^= MorrisBitboard::Bit(cpos) | MorrisBitboard::Bit(pos);
 		AfterMoveCheckMills(_cells[pos]);
 		return true;
 	}
@@ -86,6 +88,7 @@ namespace Morris
 
 		// move and clear the previous spot
 		_cells[pos] = std::move(_cells[cpos]);
+		_markerMasks[static_cast<int>(marker->GetColor())] ^= MorrisBitboard::Bit(cpos) | MorrisBitboard::Bit(pos);
 		AfterMoveCheckMills(_cells[pos]);
 		return true;
 	}
@@ -111,46 +114,37 @@ namespace Morris
 			UnformMill(mill);
 
 		_cells[pos] = nullptr;
+		_markerMasks[static_cast<int>(markerColor)] &= ~MorrisBitboard::Bit(pos);
 		return true;
 	}
 
 	int MorrisField::GetMarkerCount(MorrisPlayer player) const
 	{
-		int count = 0;
+		return MorrisBitboard::PopCount(GetMarkerMask(player));
+	}
 
-		for (const MorrisMarkerPtr marker : _cells)
-		{
-			if (marker && marker->GetColor() == player)
-				++count;
-		}
-		return count;
+	uint32_t MorrisField::GetMarkerMask(MorrisPlayer player) const
+	{
+		return _markerMasks[static_cast<int>(player)];
+	}
+
+	uint32_t MorrisField::GetEmptyMask() const
+	{
+		return MorrisBitboard::AllPoints & ~(_markerMasks[0] | _markerMasks[1]);
+	}
+
+	uint32_t MorrisField::GetMillPointsMask(MorrisPlayer player) const
+	{
+		return MorrisBitboard::GetMillPoints(GetMarkerMask(player));
 	}
 
 	bool MorrisField::Has3InARow(const MorrisMarkerPtr marker) const
 	{
-		const MorrisPlayer markerColor = marker->GetColor();
 		int markerPos = -1;
 		if (!GetMarkerPosition(markerPos, marker))
 			return false;
 
-		std::vector<std::array<int, 3>> validLines;
-
-		std::for_each(_lines.cbegin(), _lines.cend(), [&validLines, markerPos](std::array<int, 3> line)
-			{
-				bool lineValid = std::find(line.cbegin(), line.cend(), markerPos) != line.cend();
-				if (lineValid)
-					validLines.push_back(line);
-			});
-		for (std::array<int, 3> line : validLines)
-		{
-			const int pos1 = line[0], pos2 = line[1], pos3 = line[2];
-			if (_cells[pos1] && _cells[pos1]->GetColor() == markerColor)
-				if (_cells[pos2] && _cells[pos2]->GetColor() == markerColor)
-					if (_cells[pos3] && _cells[pos3]->GetColor() == markerColor)
-						return true;
-		}
-
-		return false;
+		return MorrisBitboard::FormsMill(GetMarkerMask(marker->GetColor()), markerPos);
 	}
 
 	bool MorrisField::IsMarkerPartOfMill(const MorrisMarkerPtr marker) const
@@ -174,52 +168,22 @@ namespace Morris
 		if (!GetMarkerPosition(cpos, marker))
 			return false;
 
-		for (int adjacent : _adjacents[cpos])
-		{
-			if (_cells[adjacent] == nullptr)
-				return true;
-		}
-
-		return false;
+		return (MorrisBitboard::AdjacentPoints[cpos] & GetEmptyMask()) != 0;
 	}
 
 	int MorrisField::GetPlayerMarkerCountWhichFormMills(MorrisPlayer player) const
 	{
-		int markerThatFormMillsCount = 0;
-		for (const MorrisMarkerPtr& marker : _cells)
-		{
-			if (marker && marker->GetColor() == player)
-			{
-				if (IsMarkerPartOfMill(marker))
-				{
-					++markerThatFormMillsCount;
-				}
-			}
-		}
-
-		return markerThatFormMillsCount;
+		return MorrisBitboard::PopCount(GetMillPointsMask(player));
 	}
 
 	int MorrisField::GetPlayerMarkerCountWhichDoNotFormMills(MorrisPlayer player) const
 	{
-		int markerThatDoNotFormMillsCount = 0;
-		for (const MorrisMarkerPtr& marker : _cells)
-		{
-			if (marker && marker->GetColor() == player)
-			{
-				if (!IsMarkerPartOfMill(marker))
-				{
-					++markerThatDoNotFormMillsCount;
-				}
-			}
-		}
-
-		return markerThatDoNotFormMillsCount;
+		return MorrisBitboard::PopCount(GetMarkerMask(player) & ~GetMillPointsMask(player));
 	}
 
 	bool MorrisField::AreAdjacent(int pos1, int pos2) const
 	{
-		return _adjacents[pos1].find(pos2) != _adjacents[pos1].end();
+		return (MorrisBitboard::AdjacentPoints[pos1] & MorrisBitboard::Bit(pos2)) != 0;
 	}
 
 	void MorrisField::AfterMoveCheckMills(const MorrisMarkerPtr marker)
@@ -14,14 +14,14 @@ namespace Morris
 	MorrisGame::MorrisGame(IMorrisEventListener* morrisEventListener, IMorrisLogger* logger)
 	{
 		ResetGame();
-		m_morrisEventListeners.emplace_back(morrisEventListener);
+		SubscribeToEvents(morrisEventListener);
 		if (logger)
 			m_morrisLogger = logger;
 	}
 
 	void MorrisGame::ResetGame()
 	{
-		m_morrisEventListeners.clear();
+		ClearEventListeners();
 		_eliminatedMakers.clear();
 		_unplacedMarkers.clear();
 		_placedMarkers.clear();
@@ -35,20 +35,46 @@ namespace Morris
 		_gameField.SetMillEventsCallbacks(std::bind(&MorrisGame::OnMillFormed, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), std::bind(&MorrisGame::OnMillUnformed, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
 		_gameState = MorrisGameState::Playing;
 		_currentPlayerTurn = MorrisPlayer::Player1;
+		_positionOccurrences.clear();
+		_movesWithoutMill = 0;
+		PublishSnapshot();
 	}
 
-	void MorrisGame::SubscribeToEvents(IMorrisEventListener* morrisEventListener)
+	void MorrisGame::SubscribeToEvents(IMorrisEventListener* morrisEventListener, MorrisEventMask eventMask)
 	{
-		if (std::count(m_morrisEventListeners.cbegin(), m_morrisEventListeners.cend(), morrisEventListener) > 0)
+		if (!morrisEventListener)
 			return;
 
-		m_morrisEventListeners.emplace_back(morrisEventListener);
+		for (int kind = 0; kind < static_cast<int>(MorrisEventKind::Count); ++kind)
+		{
+			std::vector<IMorrisEventListener*>& listeners = m_morrisEventListeners[kind];
+			const bool isSubscribed = std::count(listeners.cbegin(), listeners.cend(), morrisEventListener) > 0;
+			const bool wantsEvent = (eventMask & MorrisEventBit(static_cast<MorrisEventKind>(kind))) != 0;
+
+			if (wantsEvent && !isSubscribed)
+				listeners.emplace_back(morrisEventListener);
+			else if (!wantsEvent && isSubscribed)
+				RemoveEventListener(listeners, morrisEventListener);
+		}
 	}
 
 	void MorrisGame::UnsubscribeFromEvents(IMorrisEventListener* morrisEventListener)
 	{
-		if (std::count(m_morrisEventListeners.cbegin(), m_morrisEventListeners.cend(), morrisEventListener) > 0)
-			m_morrisEventListeners.erase(std::remove(m_morrisEventListeners.begin(), m_morrisEventListeners.end(), morrisEventListener));
+		if (!morrisEventListener)
+			return;
+
+		for (std::vector<IMorrisEventListener*>& listeners : m_morrisEventListeners)
+			RemoveEventListener(listeners, morrisEventListener);
+	}
+
+	void MorrisGame::SetDrawRules(const MorrisDrawRules& drawRules)
+	{
+		_drawRules = drawRules;
+	}
+
+	const MorrisDrawRules& MorrisGame::GetDrawRules() const
+	{
+		return _drawRules;
 	}
 
 	MorrisGameState MorrisGame::GetGameState() const
@@ -71,6 +97,11 @@ namespace Morris
 		return _unplacedMarkers;
 	}
 
+	MorrisSnapshot MorrisGame::GetSnapshot() const
+	{
+		return _snapshotPublisher.Read();
+	}
+
 	bool MorrisGame::PlaceMarketAtPoint(int pos, const MorrisMarkerPtr marker)
 	{
 		// check gamestate
@@ -97,10 +128,12 @@ namespace Morris
 		_gameField.SetAt(pos, marker);
 		_unplacedMarkers.erase(result);
 		_placedMarkers.push_back(marker);
+		_positionOccurrences.clear();	// earlier positions can't occur again
 
-		TRIGGER_EVENT(OnMarkerPlacedCallback, pos, marker);
+		TRIGGER_EVENT(MarkerPlaced, OnMarkerPlacedCallback, pos, marker);
 		LogMessage("Marker placed on position " + std::to_string(pos));
 		AfterMoveLogic(marker);
+		PublishSnapshot();
 		return true;
 	}
 
@@ -121,8 +154,7 @@ namespace Morris
 			return false;
 
 		// check if all markers of that color are placed on the board
-		const int64_t markerCount = std::count_if(_unplacedMarkers.begin(), _unplacedMarkers.end(), [markerColor](const MorrisMarkerPtr marker_) { return marker_->GetColor() == markerColor; });
-		if (markerCount > 0)
+		if (GetUnplacedMarkerCount(markerColor) > 0)
 			return false;
 
 		int cpos;
@@ -142,9 +174,12 @@ namespace Morris
 		if (!moveSuccess)
 			return false;
 
-		TRIGGER_EVENT(OnMarkerMovedCallback, pos, marker);
+		++_movesWithoutMill;
+
+		TRIGGER_EVENT(MarkerMoved, OnMarkerMovedCallback, pos, marker);
 		LogMessage("Marker moved to position " + std::to_string(pos));
 		AfterMoveLogic(marker);
+		PublishSnapshot();
 		return true;
 	}
 
@@ -158,13 +193,60 @@ namespace Morris
 
 		_eliminatedMakers.emplace_back(marker);
 		_placedMarkers.erase(std::remove(_placedMarkers.begin(), _placedMarkers.end(), marker), _placedMarkers.end());
+		_positionOccurrences.clear();	// earlier positions can't occur again
 
-		TRIGGER_EVENT(OnMarkerEliminatedCallback, marker);
+		TRIGGER_EVENT(MarkerEliminated, OnMarkerEliminatedCallback, marker);
 		LogMessage("Marker eliminated");
 		AfterMoveLogic(marker);
+		PublishSnapshot();
 		return true;
 	}
 
+	bool MorrisGame::ApplyMove(const MorrisMove& move)
+	{
+		switch (move.type)
+		{
+			case MorrisMoveType::Place:
+			{
+				const MorrisPlayer player = move.player;
+				auto result = std::find_if(_unplacedMarkers.cbegin(), _unplacedMarkers.cend(), [player](const MorrisMarkerPtr marker_) { return marker_->GetColor() == player; });
+				if (result == _unplacedMarkers.cend())
+					return false;
+
+				return PlaceMarketAtPoint(move.to, *result);
+			}
+
+			case MorrisMoveType::Move:
+			{
+				if (move.from < 0 || move.from > 23)
+					return false;
+
+				const MorrisMarkerPtr marker = _gameField.GetAt(move.from);
+				if (!marker || marker->GetColor() != move.player)
+					return false;
+
+				return MoveMarkerToPoint(move.to, marker);
+			}
+
+			case MorrisMoveType::Eliminate:
+			{
+				// only the player who formed the mill may eliminate
+				if (_currentPlayerTurn != move.player)
+					return false;
+
+				if (move.from < 0 || move.from > 23)
+					return false;
+
+				const MorrisMarkerPtr marker = _gameField.GetAt(move.from);
+				if (!marker)
+					return false;
+
+				return EliminateMarker(marker);
+			}
+		}
+		return false;
+	}
+
 	bool MorrisGame::CanMarkerBeEliminated(const MorrisMarkerPtr marker) const
 	{
 		// check gamestate
@@ -179,80 +261,135 @@ namespace Morris
 		if (_gameState == MorrisGameState::RemoveP2Marker && markerColor != MorrisPlayer::Player2)
 			return false;
 
-		bool canBeEliminated = false;
-		bool isMarkerPartOfMill = _gameField.IsMarkerPartOfMill(marker);
+		int pos;
+		if (!_gameField.GetMarkerPosition(pos, marker))
+			return false;
 
-		if (!isMarkerPartOfMill)
-		{
-			canBeEliminated = true;
-		}
+		return (GetEliminableMarkersMask() & MorrisBitboard::Bit(pos)) != 0;
+	}
+
+	uint32_t MorrisGame::GetPlacementTargetsMask() const
+	{
+		if (_gameState != MorrisGameState::Playing || GetUnplacedMarkerCount(_currentPlayerTurn) == 0)
+			return 0;
+
+		return _gameField.GetEmptyMask();
+	}
+
+	uint32_t MorrisGame::GetLegalDestinationsMask(int pos) const
+	{
+		if (_gameState != MorrisGameState::Playing)
+			return 0;
+
+		if (pos < 0 || pos > 23)
+			return 0;
+
+		const MorrisMarkerPtr marker = _gameField.GetAt(pos);
+		if (!marker || marker->GetColor() != _currentPlayerTurn)
+			return 0;
+
+		if (GetUnplacedMarkerCount(_currentPlayerTurn) > 0)
+			return 0;
+
+		// with exactly 3 markers left the player can jump anywhere
+		if (_gameField.GetMarkerCount(_currentPlayerTurn) == 3)
+			return _gameField.GetEmptyMask();
+
+		return MorrisBitboard::AdjacentPoints[pos] & _gameField.GetEmptyMask();
+	}
+
+	uint32_t MorrisGame::GetMovableMarkersMask(MorrisPlayer player) const
+	{
+		if (GetUnplacedMarkerCount(player) > 0)
+			return 0;
+
+		const uint32_t playerMarkers = _gameField.GetMarkerMask(player);
+		const uint32_t emptyPoints = _gameField.GetEmptyMask();
+		if (MorrisBitboard::PopCount(playerMarkers) == 3)
+			return emptyPoints ? playerMarkers : 0;
+
+		return MorrisBitboard::GetPointsWithFreeNeighbour(playerMarkers, emptyPoints);
+	}
+
+	uint32_t MorrisGame::GetEliminableMarkersMask() const
+	{
+		MorrisPlayer victim;
+		if (_gameState == MorrisGameState::RemoveP1Marker)
+			victim = MorrisPlayer::Player1;
+		else if (_gameState == MorrisGameState::RemoveP2Marker)
+			victim = MorrisPlayer::Player2;
 		else
+			return 0;
+
+		const uint32_t victimMarkers = _gameField.GetMarkerMask(victim);
+		const uint32_t markersOutsideMills = victimMarkers & ~_gameField.GetMillPointsMask(victim);
+
+		// exception is made when all player's markers form mills
+		return markersOutsideMills ? markersOutsideMills : victimMarkers;
+	}
+
+	std::vector<MorrisMove> MorrisGame::GetLegalMoves() const
+	{
+		std::vector<MorrisMove> moves;
+		const MorrisPlayer player = _currentPlayerTurn;
+
+		for (uint32_t targets = GetEliminableMarkersMask(); targets; targets &= targets - 1)
+			moves.emplace_back(MorrisMove::Elimination(player, MorrisBitboard::LowestPoint(targets)));
+
+		for (uint32_t targets = GetPlacementTargetsMask(); targets; targets &= targets - 1)
+			moves.emplace_back(MorrisMove::Placement(player, MorrisBitboard::LowestPoint(targets)));
+
+		if (_gameState == MorrisGameState::Playing)
 		{
-			const int markersThatDontFormMillsCount = _gameField.GetPlayerMarkerCountWhichDoNotFormMills(markerColor);
-			if (markersThatDontFormMillsCount == 0) // exception is made when all player's markers form mills
-			{
-				canBeEliminated = true;
-			}
-			else
+			for (uint32_t markers = GetMovableMarkersMask(player); markers; markers &= markers - 1)
 			{
-				canBeEliminated = false;
+				const int from = MorrisBitboard::LowestPoint(markers);
+				for (uint32_t targets = GetLegalDestinationsMask(from); targets; targets &= targets - 1)
+					moves.emplace_back(MorrisMove::Movement(player, from, MorrisBitboard::LowestPoint(targets)));
 			}
 		}
-
-		return canBeEliminated;
+		return moves;
 	}
 
 	void MorrisGame::OnMillFormed(int pos1, int pos2, int pos3, MorrisPlayer player)
 	{
 		LogMessage("Mill formed: " + std::to_string(pos1) + " " + std::to_string(pos2) + " " + std::to_string(pos3));
-		TRIGGER_EVENT(OnMillFormed, pos1, pos2, pos3, player);
+		TRIGGER_EVENT(MillFormed, OnMillFormed, pos1, pos2, pos3, player);
 	}
 
 	void MorrisGame::OnMillUnformed(int pos1, int pos2, int pos3, MorrisPlayer player)
 	{
 		LogMessage("Mill unformed: " + std::to_string(pos1) + " " + std::to_string(pos2) + " " + std::to_string(pos3));
-		TRIGGER_EVENT(OnMillUnFormed, pos1, pos2, pos3, player);
+		TRIGGER_EVENT(MillUnformed, OnMillUnFormed, pos1, pos2, pos3, player);
 	}
 	
 	bool MorrisGame::CanPlayerMakeAMove(MorrisPlayer player) const
 	{
 		// if player has unplaced markers player can still make a move
-		const int64_t unplacedMarkerCount = std::count_if(_unplacedMarkers.cbegin(), _unplacedMarkers.cend(), [player](const MorrisMarkerPtr marker_) { return marker_->GetColor() == player; });
-		if (unplacedMarkerCount > 0)
+		if (GetUnplacedMarkerCount(player) > 0)
 			return true;
-		
+
 		// check if any player marker has any adjencent free spots, if yes, return true, if false player loses
 		const int playerMarkerCount = _gameField.GetMarkerCount(player);
 		if (playerMarkerCount > 3)
 		{
-			std::vector<MorrisMarkerPtr> playerPlacedMarkers;
-			std::copy_if(_placedMarkers.cbegin(), _placedMarkers.cend(), std::back_inserter(playerPlacedMarkers), [player](MorrisMarkerPtr marker)
-			{
-				return marker->GetColor() == player;
-			});
-
-			bool playerCanMove = false;
-			for (const MorrisMarkerPtr& marker : playerPlacedMarkers)
-			{
-				if (_gameField.CanMarkerBeMoved(marker))
-				{
-					playerCanMove = true;
-					break;
-				}
-			}
-
-			if (!playerCanMove)	// player is stuck
+			if (GetMovableMarkersMask(player) == 0)	// player is stuck
 				return false;
-		}		
-		
+		}
+
 		// player can definitely make a move
 		return true;
 	}
 
+	int MorrisGame::GetUnplacedMarkerCount(MorrisPlayer player) const
+	{
+		return static_cast<int>(std::count_if(_unplacedMarkers.cbegin(), _unplacedMarkers.cend(), [player](const MorrisMarkerPtr& marker_) { return marker_->GetColor() == player; }));
+	}
+
 	void MorrisGame::ChangePlayerTurn()
 	{
 		_currentPlayerTurn = (_currentPlayerTurn == MorrisPlayer::Player1) ? MorrisPlayer::Player2 : MorrisPlayer::Player1;
-		TRIGGER_EVENT(OnPlayerTurnChangedCallback, _currentPlayerTurn);
+		TRIGGER_EVENT(PlayerTurnChanged, OnPlayerTurnChangedCallback, _currentPlayerTurn);
 		LogMessage("Player turn changed");
 	}
 
@@ -268,7 +405,7 @@ namespace Morris
 				if (_gameField.GetMarkerCount(MorrisPlayer::Player1) < 3 && unplacedMarkersCount == 0)
 				{
 					_gameState = MorrisGameState::P2Wins;
-					TRIGGER_EVENT(OnPlayerWinCallback, MorrisPlayer::Player2);
+					TRIGGER_EVENT(PlayerWin, OnPlayerWinCallback, MorrisPlayer::Player2);
 					LogMessage("Player 2 wins");
 					break;
 				}
@@ -276,7 +413,7 @@ namespace Morris
 				if (_gameField.GetMarkerCount(MorrisPlayer::Player2) < 3 && unplacedMarkersCount == 0)
 				{
 					_gameState = MorrisGameState::P1Wins;
-					TRIGGER_EVENT(OnPlayerWinCallback, MorrisPlayer::Player1);
+					TRIGGER_EVENT(PlayerWin, OnPlayerWinCallback, MorrisPlayer::Player1);
 					LogMessage("Player 1 wins");
 					break;
 				}
@@ -288,7 +425,7 @@ namespace Morris
 				if (!CanPlayerMakeAMove(oposingPlayer))
 				{
 					_gameState = (_currentPlayerTurn == MorrisPlayer::Player1) ? MorrisGameState::P1Wins : MorrisGameState::P2Wins;
-					TRIGGER_EVENT(OnPlayerWinCallback, _currentPlayerTurn);
+					TRIGGER_EVENT(PlayerWin, OnPlayerWinCallback, _currentPlayerTurn);
 					LogMessage("Game over");
 				}
 				else
@@ -306,6 +443,7 @@ namespace Morris
 				// after a player removes a marker then change the turn
 				if (_gameField.Has3InARow(marker))
 				{
+					_movesWithoutMill = 0;
 					if (_currentPlayerTurn == MorrisPlayer::Player1)
 					{
 						_gameState = MorrisGameState::RemoveP2Marker;
@@ -322,7 +460,7 @@ namespace Morris
 					if (!CanPlayerMakeAMove(oposingPlayer))
 					{
 						_gameState = (_currentPlayerTurn == MorrisPlayer::Player1) ? MorrisGameState::P1Wins : MorrisGameState::P2Wins;
-						TRIGGER_EVENT(OnPlayerWinCallback, _currentPlayerTurn);
+						TRIGGER_EVENT(PlayerWin, OnPlayerWinCallback, _currentPlayerTurn);
 						LogMessage("Game over");
 					}
 					else
@@ -337,13 +475,95 @@ namespace Morris
 				break;
 		}
 
+		if (_gameState == MorrisGameState::Playing)
+			CheckDrawRules();
+
 		if (prevGameState != _gameState)
 		{
-			TRIGGER_EVENT(OnGamestateChangedCallback, prevGameState, _gameState);
+			TRIGGER_EVENT(GamestateChanged, OnGamestateChangedCallback, prevGameState, _gameState);
 			LogMessage("Game state changed");
 		}
 	}
 	
+	void MorrisGame::CheckDrawRules()
+	{
+		if (_drawRules.repetitionLimit > 0)
+		{
+			const int occurrences = ++_positionOccurrences[GetPositionKey()];
+			if (occurrences >= _drawRules.repetitionLimit)
+			{
+				_gameState = MorrisGameState::Draw;
+				TRIGGER_EVENT(GameDrawn, OnGameDrawnCallback, MorrisDrawReason::Repetition);
+				LogMessage("Game drawn by repetition");
+				return;
+			}
+		}
+
+		if (_drawRules.movesWithoutMillLimit > 0 && _movesWithoutMill >= _drawRules.movesWithoutMillLimit)
+		{
+			_gameState = MorrisGameState::Draw;
+			TRIGGER_EVENT(GameDrawn, OnGameDrawnCallback, MorrisDrawReason::MoveLimit);
+			LogMessage("Game drawn by move limit");
+		}
+	}
+
+	uint64_t MorrisGame::GetPositionKey() const
+	{
+		// both boards and the side to move fit in one word, so the key is exact rather than a hash
+		return static_cast<uint64_t>(_gameField.GetMarkerMask(MorrisPlayer::Player1))
+			| (static_cast<uint64_t>(_gameField.GetMarkerMask(MorrisPlayer::Player2)) << 24)
+			| (static_cast<uint64_t>(_currentPlayerTurn) << 48);
+	}
+
+	void MorrisGame::PublishSnapshot()
+	{
+		MorrisSnapshot snapshot;
+		snapshot.player1Markers = _gameField.GetMarkerMask(MorrisPlayer::Player1);
+		snapshot.player2Markers = _gameField.GetMarkerMask(MorrisPlayer::Player2);
+		snapshot.gameState = _gameState;
+		snapshot.currentPlayerTurn = _currentPlayerTurn;
+		snapshot.unplacedPlayer1Markers = GetUnplacedMarkerCount(MorrisPlayer::Player1);
+		snapshot.unplacedPlayer2Markers = static_cast<int>(_unplacedMarkers.size()) - snapshot.unplacedPlayer1Markers;
+		_snapshotPublisher.Publish(snapshot);
+	}
+
+	void MorrisGame::RemoveEventListener(std::vector<IMorrisEventListener*>& listeners, IMorrisEventListener* morrisEventListener)
+	{
+		if (m_eventDispatchDepth == 0)
+		{
+			listeners.erase(std::remove(listeners.begin(), listeners.end(), morrisEventListener), listeners.end());
+			return;
+		}
+
+		// a dispatch is iterating the lists, keep indices stable until it finishes
+		std::replace(listeners.begin(), listeners.end(), morrisEventListener, static_cast<IMorrisEventListener*>(nullptr));
+		m_hasRemovedEventListeners = true;
+	}
+
+	void MorrisGame::ClearEventListeners()
+	{
+		for (std::vector<IMorrisEventListener*>& listeners : m_morrisEventListeners)
+		{
+			if (m_eventDispatchDepth == 0)
+			{
+				listeners.clear();
+			}
+			else
+			{
+				std::fill(listeners.begin(), listeners.end(), nullptr);
+				m_hasRemovedEventListeners = true;
+			}
+		}
+	}
+
+	void MorrisGame::CompactEventListeners()
+	{
+		for (std::vector<IMorrisEventListener*>& listeners : m_morrisEventListeners)
+			listeners.erase(std::remove(listeners.begin(), listeners.end(), nullptr), listeners.end());
+
+		m_hasRemovedEventListeners = false;
+	}
+
 	void MorrisGame::LogMessage(const std::string& message)
 	{
 		if (m_morrisLogger)
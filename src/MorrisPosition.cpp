@@ -0,0 +1,256 @@
+#include <MorrisPosition.h>
+#include <MorrisBitboard.h>
+
+namespace Morris
+{
+	MorrisPosition::MorrisPosition() :
+		_markers({{ 0, 0 }}),
+		_unplaced({{ 9, 9 }})
+	{
+
+	}
+
+	MorrisPosition MorrisPosition::FromSnapshot(const MorrisSnapshot& snapshot)
+	{
+		MorrisPosition position;
+		position._markers = {{ snapshot.player1Markers, snapshot.player2Markers }};
+		position._unplaced = {{ static_cast<uint8_t>(snapshot.unplacedPlayer1Markers), static_cast<uint8_t>(snapshot.unplacedPlayer2Markers) }};
+		position._sideToMove = snapshot.currentPlayerTurn;
+		position._gameState = snapshot.gameState;
+		return position;
+	}
+
+	MorrisPosition MorrisPosition::FromMasks(uint32_t player1Markers, uint32_t player2Markers, int unplacedPlayer1Markers, int unplacedPlayer2Markers, MorrisPlayer sideToMove)
+	{
+		MorrisPosition position;
+		position._markers = {{ player1Markers, player2Markers }};
+		position._unplaced = {{ static_cast<uint8_t>(unplacedPlayer1Markers), static_cast<uint8_t>(unplacedPlayer2Markers) }};
+		position._sideToMove = sideToMove;
+
+		// a side to move that is already beaten is recorded as such, the same way MorrisGame ends the game after the previous move
+		const bool allPlaced = unplacedPlayer1Markers + unplacedPlayer2Markers == 0;
+		const bool isBeaten = (allPlaced && position.GetMarkerCount(sideToMove) < 3) || !position.CanPlayerMakeAMove(sideToMove);
+		if (isBeaten)
+			position._gameState = (sideToMove == MorrisPlayer::Player1) ? MorrisGameState::P2Wins : MorrisGameState::P1Wins;
+
+		return position;
+	}
+
+	uint32_t MorrisPosition::GetMarkerMask(MorrisPlayer player) const
+	{
+		return _markers[static_cast<int>(player)];
+	}
+
+	uint32_t MorrisPosition::GetEmptyMask() const
+	{
+		return MorrisBitboard::AllPoints & ~(_markers[0] | _markers[1]);
+	}
+
+	int MorrisPosition::GetMarkerCount(MorrisPlayer player) const
+	{
+		return MorrisBitboard::PopCount(GetMarkerMask(player));
+	}
+
+	int MorrisPosition::GetUnplacedMarkerCount(MorrisPlayer player) const
+	{
+		return _unplaced[static_cast<int>(player)];
+	}
+
+	MorrisPlayer MorrisPosition::GetSideToMove() const
+	{
+		return _sideToMove;
+	}
+
+	MorrisGameState MorrisPosition::GetGameState() const
+	{
+		return _gameState;
+	}
+
+	bool MorrisPosition::IsGameOver() const
+	{
+		return _gameState == MorrisGameState::P1Wins || _gameState == MorrisGameState::P2Wins || _gameState == MorrisGameState::Draw;
+	}
+
+	uint64_t MorrisPosition::GetKey() const
+	{
+		return static_cast<uint64_t>(_markers[0])
+			| (static_cast<uint64_t>(_markers[1]) << 24)
+			| (static_cast<uint64_t>(_unplaced[0]) << 48)
+			| (static_cast<uint64_t>(_unplaced[1]) << 52)
+			| (static_cast<uint64_t>(_sideToMove) << 56)
+			| (static_cast<uint64_t>(_gameState) << 57);
+	}
+
+	int MorrisPosition::GenerateMoves(MoveList& moves) const
+	{
+		int count = 0;
+		const MorrisPlayer player = _sideToMove;
+
+		if (_gameState == MorrisGameState::RemoveP1Marker || _gameState == MorrisGameState::RemoveP2Marker)
+		{
+			for (uint32_t targets = GetEliminableMarkersMask(); targets; targets &= targets - 1)
+				moves[count++] = MorrisMove::Elimination(player, MorrisBitboard::LowestPoint(targets));
+			return count;
+		}
+
+		if (_gameState != MorrisGameState::Playing)
+			return 0;
+
+		const uint32_t emptyPoints = GetEmptyMask();
+		if (GetUnplacedMarkerCount(player) > 0)
+		{
+			for (uint32_t targets = emptyPoints; targets; targets &= targets - 1)
+				moves[count++] = MorrisMove::Placement(player, MorrisBitboard::LowestPoint(targets));
+			return count;
+		}
+
+		const bool canJump = GetMarkerCount(player) == 3;
+		for (uint32_t markers = GetMarkerMask(player); markers; markers &= markers - 1)
+		{
+			const int from = MorrisBitboard::LowestPoint(markers);
+			const uint32_t destinations = canJump ? emptyPoints : (MorrisBitboard::AdjacentPoints[from] & emptyPoints);
+			for (uint32_t targets = destinations; targets; targets &= targets - 1)
+				moves[count++] = MorrisMove::Movement(player, from, MorrisBitboard::LowestPoint(targets));
+		}
+		return count;
+	}
+
+	bool MorrisPosition::IsLegalMove(const MorrisMove& move) const
+	{
+		const MorrisPlayer player = _sideToMove;
+		if (move.player != player)
+			return false;
+
+		switch (move.type)
+		{
+			case MorrisMoveType::Place:
+				if (_gameState != MorrisGameState::Playing || GetUnplacedMarkerCount(player) == 0)
+					return false;
+				return move.to >= 0 && move.to < 24 && (GetEmptyMask() & MorrisBitboard::Bit(move.to));
+
+			case MorrisMoveType::Move:
+			{
+				if (_gameState != MorrisGameState::Playing || GetUnplacedMarkerCount(player) > 0)
+					return false;
+				if (move.from < 0 || move.from > 23 || move.to < 0 || move.to > 23)
+					return false;
+				if (!(GetMarkerMask(player) & MorrisBitboard::Bit(move.from)) || !(GetEmptyMask() & MorrisBitboard::Bit(move.to)))
+					return false;
+				return GetMarkerCount(player) == 3 || (MorrisBitboard::AdjacentPoints[move.from] & MorrisBitboard::Bit(move.to));
+			}
+
+			case MorrisMoveType::Eliminate:
+				return move.from >= 0 && move.from < 24 && (GetEliminableMarkersMask() & MorrisBitboard::Bit(move.from));
+		}
+		return false;
+	}
+
+	void MorrisPosition::MakeMove(const MorrisMove& move)
+	{
+		const int player = static_cast<int>(_sideToMove);
+		switch (move.type)
+		{
+			case MorrisMoveType::Place:
+				_markers[player] |= MorrisBitboard::Bit(move.to);
+				--_unplaced[player];
+				AfterPlacementOrMove(move.to);
+				break;
+
+			case MorrisMoveType::Move:
+				_markers[player] ^= MorrisBitboard::Bit(move.from) | MorrisBitboard::Bit(move.to);
+				AfterPlacementOrMove(move.to);
+				break;
+
+			case MorrisMoveType::Eliminate:
+				_markers[1 - player] &= ~MorrisBitboard::Bit(move.from);
+				AfterElimination();
+				break;
+		}
+	}
+
+	bool MorrisPosition::ApplyMove(const MorrisMove& move)
+	{
+		if (!IsLegalMove(move))
+			return false;
+
+		MakeMove(move);
+		return true;
+	}
+
+	bool MorrisPosition::operator==(const MorrisPosition& other) const
+	{
+		return GetKey() == other.GetKey();
+	}
+
+	bool MorrisPosition::CanPlayerMakeAMove(MorrisPlayer player) const
+	{
+		if (GetUnplacedMarkerCount(player) > 0)
+			return true;
+
+		// with 3 or fewer markers the player can jump
+		if (GetMarkerCount(player) <= 3)
+			return true;
+
+		return MorrisBitboard::GetPointsWithFreeNeighbour(GetMarkerMask(player), GetEmptyMask()) != 0;
+	}
+
+	uint32_t MorrisPosition::GetEliminableMarkersMask() const
+	{
+		const MorrisPlayer victim = (_gameState == MorrisGameState::RemoveP1Marker) ? MorrisPlayer::Player1 : MorrisPlayer::Player2;
+		if (_gameState != MorrisGameState::RemoveP1Marker && _gameState != MorrisGameState::RemoveP2Marker)
+			return 0;
+
+		const uint32_t victimMarkers = GetMarkerMask(victim);
+		const uint32_t markersOutsideMills = victimMarkers & ~MorrisBitboard::GetMillPoints(victimMarkers);
+
+		// exception is made when all player's markers form mills
+		return markersOutsideMills ? markersOutsideMills : victimMarkers;
+	}
+
+	void MorrisPosition::AfterPlacementOrMove(int pos)
+	{
+		if (MorrisBitboard::FormsMill(GetMarkerMask(_sideToMove), pos))
+		{
+			_gameState = (_sideToMove == MorrisPlayer::Player1) ? MorrisGameState::RemoveP2Marker : MorrisGameState::RemoveP1Marker;
+			return;
+		}
+
+		const MorrisPlayer opponent = Opponent(_sideToMove);
+		if (!CanPlayerMakeAMove(opponent))
+		{
+			_gameState = (_sideToMove == MorrisPlayer::Player1) ? MorrisGameState::P1Wins : MorrisGameState::P2Wins;
+			return;
+		}
+		_sideToMove = opponent;
+	}
+
+	void MorrisPosition::AfterElimination()
+	{
+		const bool allPlaced = _unplaced[0] + _unplaced[1] == 0;
+		if (allPlaced && GetMarkerCount(MorrisPlayer::Player1) < 3)
+		{
+			_gameState = MorrisGameState::P2Wins;
+			return;
+		}
+
+		if (allPlaced && GetMarkerCount(MorrisPlayer::Player2) < 3)
+		{
+			_gameState = MorrisGameState::P1Wins;
+			return;
+		}
+
+		_gameState = MorrisGameState::Playing;
+		const MorrisPlayer opponent = Opponent(_sideToMove);
+		if (!CanPlayerMakeAMove(opponent))
+		{
+			_gameState = (_sideToMove == MorrisPlayer::Player1) ? MorrisGameState::P1Wins : MorrisGameState::P2Wins;
+			return;
+		}
+		_sideToMove = opponent;
+	}
+
+	MorrisPlayer MorrisPosition::Opponent(MorrisPlayer player)
+	{
+		return (player == MorrisPlayer::Player1) ? MorrisPlayer::Player2 : MorrisPlayer::Player1;
+	}
+}
\ No newline at end of file
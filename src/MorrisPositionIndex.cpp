@@ -0,0 +1,217 @@
+#include <MorrisPositionIndex.h>
+#include <MorrisBitboard.h>
+#include <algorithm>
+#include <array>
+
+namespace Morris
+{
+	namespace
+	{
+		struct BinomialTable
+		{
+			BinomialTable()
+			{
+				for (int n = 0; n <= 24; ++n)
+				{
+					values[n][0] = 1;
+					for (int k = 1; k <= n; ++k)
+						values[n][k] = values[n - 1][k - 1] + (k < n ? values[n - 1][k] : 0);
+				}
+			}
+
+			uint64_t values[25][25] = {};
+		};
+
+		const BinomialTable& GetBinomialTable()
+		{
+			static const BinomialTable table;
+			return table;
+		}
+
+		uint32_t GetSmallestImage(uint32_t points)
+		{
+			uint32_t smallest = points;
+			for (int symmetry = 1; symmetry < MorrisBitboard::SymmetryCount; ++symmetry)
+				smallest = std::min(smallest, MorrisBitboard::ApplySymmetry(symmetry, points));
+
+			return smallest;
+		}
+	}
+
+	MorrisSubspace MorrisSubspace::FromPosition(const MorrisPosition& position)
+	{
+		MorrisSubspace subspace;
+		subspace.player1Markers = position.GetMarkerCount(MorrisPlayer::Player1);
+		subspace.player2Markers = position.GetMarkerCount(MorrisPlayer::Player2);
+		subspace.unplacedPlayer1Markers = position.GetUnplacedMarkerCount(MorrisPlayer::Player1);
+		subspace.unplacedPlayer2Markers = position.GetUnplacedMarkerCount(MorrisPlayer::Player2);
+		subspace.sideToMove = position.GetSideToMove();
+		return subspace;
+	}
+
+	bool MorrisSubspace::operator==(const MorrisSubspace& other) const
+	{
+		return player1Markers == other.player1Markers && player2Markers == other.player2Markers
+			&& unplacedPlayer1Markers == other.unplacedPlayer1Markers && unplacedPlayer2Markers == other.unplacedPlayer2Markers
+			&& sideToMove == other.sideToMove;
+	}
+
+	MorrisPositionIndexer::MorrisPositionIndexer(const MorrisSubspace& subspace, bool useSymmetry) :
+		_subspace(subspace),
+		_useSymmetry(useSymmetry)
+	{
+		_player2Configurations = GetBinomial(24 - subspace.player1Markers, subspace.player2Markers);
+
+		if (!_useSymmetry)
+		{
+			_size = GetBinomial(24, subspace.player1Markers) * _player2Configurations;
+			return;
+		}
+
+		// numeric order of the masks matches their rank, so a representative is the smallest mask of its class
+		const int count = subspace.player1Markers;
+		if (count >= 0 && count <= 24)
+		{
+			const uint32_t lastPoints = MorrisBitboard::AllPoints & ~(MorrisBitboard::AllPoints >> count);
+			uint32_t points = MorrisBitboard::AllPoints >> (24 - count);
+			while (true)
+			{
+				if (GetSmallestImage(points) == points)
+					_player1Representatives.push_back(points);
+
+				if (points == lastPoints)
+					break;
+
+				// next larger mask with the same number of points
+				const uint32_t lowest = points & (~points + 1);
+				const uint32_t ripple = points + lowest;
+				points = ripple | (((ripple ^ points) >> 2) / lowest);
+			}
+		}
+
+		_size = _player1Representatives.size() * _player2Configurations;
+	}
+
+	const MorrisSubspace& MorrisPositionIndexer::GetSubspace() const
+	{
+		return _subspace;
+	}
+
+	bool MorrisPositionIndexer::IsSymmetryReduced() const
+	{
+		return _useSymmetry;
+	}
+
+	uint64_t MorrisPositionIndexer::GetSize() const
+	{
+		return _size;
+	}
+
+	bool MorrisPositionIndexer::Contains(const MorrisPosition& position) const
+	{
+		return MorrisSubspace::FromPosition(position) == _subspace;
+	}
+
+	uint64_t MorrisPositionIndexer::Rank(const MorrisPosition& position) const
+	{
+		return RankBoard(position.GetMarkerMask(MorrisPlayer::Player1), position.GetMarkerMask(MorrisPlayer::Player2));
+	}
+
+	MorrisPosition MorrisPositionIndexer::Unrank(uint64_t index) const
+	{
+		const uint64_t player1Index = index / _player2Configurations;
+		const uint32_t player1Markers = _useSymmetry ? _player1Representatives[player1Index] : UnrankPoints(player1Index, _subspace.player1Markers);
+		const uint32_t player2Markers = ExpandPoints(UnrankPoints(index % _player2Configurations, _subspace.player2Markers), MorrisBitboard::AllPoints & ~player1Markers);
+
+		return MorrisPosition::FromMasks(player1Markers, player2Markers, _subspace.unplacedPlayer1Markers, _subspace.unplacedPlayer2Markers, _subspace.sideToMove);
+	}
+
+	bool MorrisPositionIndexer::IsCanonicalIndex(uint64_t index) const
+	{
+		if (!_useSymmetry)
+			return true;
+
+		const uint32_t player1Markers = _player1Representatives[index / _player2Configurations];
+		const uint32_t player2Markers = ExpandPoints(UnrankPoints(index % _player2Configurations, _subspace.player2Markers), MorrisBitboard::AllPoints & ~player1Markers);
+		return RankBoard(player1Markers, player2Markers) == index;
+	}
+
+	uint64_t MorrisPositionIndexer::GetBinomial(int n, int k)
+	{
+		if (n < 0 || n > 24 || k < 0 || k > n)
+			return 0;
+
+		return GetBinomialTable().values[n][k];
+	}
+
+	uint64_t MorrisPositionIndexer::RankBoard(uint32_t player1Markers, uint32_t player2Markers) const
+	{
+		if (!_useSymmetry)
+			return RankPoints(player1Markers) * _player2Configurations + RankPoints(CompressPoints(player2Markers, MorrisBitboard::AllPoints & ~player1Markers));
+
+		// the canonical form has the smallest player 1 mask and, among the symmetries that produce it, the smallest player 2 mask
+		std::array<uint32_t, MorrisBitboard::SymmetryCount> player1Images;
+		for (int symmetry = 0; symmetry < MorrisBitboard::SymmetryCount; ++symmetry)
+			player1Images[symmetry] = MorrisBitboard::ApplySymmetry(symmetry, player1Markers);
+
+		const uint32_t bestPlayer1 = *std::min_element(player1Images.begin(), player1Images.end());
+		uint32_t bestPlayer2 = MorrisBitboard::AllPoints;
+		for (int symmetry = 0; symmetry < MorrisBitboard::SymmetryCount; ++symmetry)
+		{
+			if (player1Images[symmetry] == bestPlayer1)
+				bestPlayer2 = std::min(bestPlayer2, CompressPoints(MorrisBitboard::ApplySymmetry(symmetry, player2Markers), MorrisBitboard::AllPoints & ~bestPlayer1));
+		}
+
+		const auto representative = std::lower_bound(_player1Representatives.begin(), _player1Representatives.end(), bestPlayer1);
+		return static_cast<uint64_t>(representative - _player1Representatives.begin()) * _player2Configurations + RankPoints(bestPlayer2);
+	}
+
+	uint64_t MorrisPositionIndexer::RankPoints(uint32_t points)
+	{
+		// combinatorial number system, the k-th smallest point p adds C(p, k)
+		const BinomialTable& binomials = GetBinomialTable();
+		uint64_t rank = 0;
+		for (int k = 1; points; points &= points - 1, ++k)
+			rank += binomials.values[MorrisBitboard::LowestPoint(points)][k];
+
+		return rank;
+	}
+
+	uint32_t MorrisPositionIndexer::UnrankPoints(uint64_t rank, int count)
+	{
+		const BinomialTable& binomials = GetBinomialTable();
+		uint32_t points = 0;
+		int pos = 24;
+		for (int k = count; k > 0; --k)
+		{
+			do
+			{
+				--pos;
+			} while (binomials.values[pos][k] > rank);
+
+			rank -= binomials.values[pos][k];
+			points |= MorrisBitboard::Bit(pos);
+		}
+		return points;
+	}
+
+	uint32_t MorrisPositionIndexer::CompressPoints(uint32_t points, uint32_t freePoints)
+	{
+		uint32_t result = 0;
+		for (; points; points &= points - 1)
+		{
+			const uint32_t bit = points & (~points + 1);
+			result |= MorrisBitboard::Bit(MorrisBitboard::PopCount(freePoints & (bit - 1)));
+		}
+		return result;
+	}
+
+	uint32_t MorrisPositionIndexer::ExpandPoints(uint32_t points, uint32_t freePoints)
+	{
+		uint32_t result = 0;
+		for (; points; points >>= 1, freePoints &= freePoints - 1)
+			result |= freePoints & (~freePoints + 1) & (0u - (points & 1u));
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include <MorrisProofNumberSolver.h>
+#include <algorithm>
+
+namespace Morris
+{
+	namespace
+	{
+		const uint32_t Infinity = 100000000;
+
+		uint32_t SaturatingAdd(uint32_t a, uint32_t b)
+		{
+			return std::min<uint64_t>(static_cast<uint64_t>(a) + b, Infinity);
+		}
+	}
+
+	MorrisProofNumberSolver::MorrisProofNumberSolver(const MorrisSolverConfig& config) :
+		_config(config)
+	{
+		size_t entries = 2;
+		while (entries * 2 <= _config.hashTableEntries)
+			entries *= 2;
+
+		_table.resize(entries);
+	}
+
+	MorrisSolverSolution MorrisProofNumberSolver::Solve(const MorrisPosition& position)
+	{
+		MorrisSolverSolution solution;
+		_nodes = 0;
+		_isAborted = false;
+		_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_config.timeLimitMilliseconds);
+
+		const MorrisPlayer sideToMove = position.GetSideToMove();
+		const MorrisPlayer opponent = (sideToMove == MorrisPlayer::Player1) ? MorrisPlayer::Player2 : MorrisPlayer::Player1;
+
+		// both searches share the node and time budget
+		if (ProveWin(position, sideToMove))
+			solution.result = MorrisSolverResult::Win;
+		else if (!_isAborted && ProveWin(position, opponent))
+			solution.result = MorrisSolverResult::Loss;
+
+		if (solution.result != MorrisSolverResult::Unknown)
+			solution.principalLine = ExtractPrincipalLine(position);
+
+		solution.nodes = _nodes;
+		return solution;
+	}
+
+	bool MorrisProofNumberSolver::ProveWin(const MorrisPosition& root, MorrisPlayer attacker)
+	{
+		// the stored numbers only make sense for one attacker
+		std::fill(_table.begin(), _table.end(), Entry());
+		_attacker = attacker;
+		return SearchRoot(root);
+	}
+
+	bool MorrisProofNumberSolver::SearchRoot(const MorrisPosition& root)
+	{
+		_path.clear();
+
+		uint32_t proofNumber, disproofNumber;
+		GetChildNumbers(root, 0, proofNumber, disproofNumber);
+		if (proofNumber == 0 || disproofNumber == 0)
+			return proofNumber == 0;
+
+		Search(root, Infinity, Infinity, 0);
+
+		const Entry* entry = Lookup(root.GetKey());
+		return entry && entry->proofNumber == 0;
+	}
+
+	void MorrisProofNumberSolver::Search(const MorrisPosition& position, uint32_t proofThreshold, uint32_t disproofThreshold, int depth)
+	{
+		const uint64_t key = position.GetKey();
+		const uint64_t nodesBefore = _nodes++;
+		const bool isOrNode = position.GetSideToMove() == _attacker;
+
+		MorrisPosition::MoveList moves;
+		const int moveCount = position.GenerateMoves(moves);
+		if (moveCount == 0)	// a side that can't move loses
+		{
+			const bool isAttackerWin = !isOrNode;
+			Store(key, isAttackerWin ? 0 : Infinity, isAttackerWin ? Infinity : 0, 1);
+			return;
+		}
+
+		std::vector<MorrisPosition> children(moveCount, position);
+		for (int i = 0; i < moveCount; ++i)
+			children[i].MakeMove(moves[i]);
+
+		_path.insert(key);
+
+		uint32_t proofNumber = 0, disproofNumber = 0;
+		while (true)
+		{
+			// OR nodes take the minimum proof number and sum the disproof numbers, AND nodes the other way around
+			int bestChild = -1;
+			uint32_t bestValue = Infinity, secondValue = Infinity;
+			uint32_t bestProof = 0, bestDisproof = 0;
+			proofNumber = isOrNode ? Infinity : 0;
+			disproofNumber = isOrNode ? 0 : Infinity;
+
+			for (int i = 0; i < moveCount; ++i)
+			{
+				uint32_t childProof, childDisproof;
+				GetChildNumbers(children[i], depth + 1, childProof, childDisproof);
+
+				const uint32_t value = isOrNode ? childProof : childDisproof;
+				if (isOrNode)
+				{
+					proofNumber = std::min(proofNumber, childProof);
+					disproofNumber = SaturatingAdd(disproofNumber, childDisproof);
+				}
+				else
+				{
+					proofNumber = SaturatingAdd(proofNumber, childProof);
+					disproofNumber = std::min(disproofNumber, childDisproof);
+				}
+
+				if (bestChild < 0 || value < bestValue)
+				{
+					secondValue = bestValue;
+					bestValue = value;
+					bestChild = i;
+					bestProof = childProof;
+					bestDisproof = childDisproof;
+				}
+				else if (value < secondValue)
+				{
+					secondValue = value;
+				}
+			}
+
+			if (proofNumber >= proofThreshold || disproofNumber >= disproofThreshold)
+				break;
+
+			if (IsBudgetExhausted())
+				break;
+
+			uint32_t childProofThreshold, childDisproofThreshold;
+			if (isOrNode)
+			{
+				childProofThreshold = std::min(proofThreshold, SaturatingAdd(secondValue, 1));
+				childDisproofThreshold = (disproofThreshold >= Infinity) ? Infinity : disproofThreshold - disproofNumber + bestDisproof;
+			}
+			else
+			{
+				childDisproofThreshold = std::min(disproofThreshold, SaturatingAdd(secondValue, 1));
+				childProofThreshold = (proofThreshold >= Infinity) ? Infinity : proofThreshold - proofNumber + bestProof;
+			}
+
+			Search(children[bestChild], childProofThreshold, childDisproofThreshold, depth + 1);
+			if (_isAborted)
+				break;
+		}
+
+		_path.erase(key);
+		Store(key, proofNumber, disproofNumber, _nodes - nodesBefore);
+	}
+
+	void MorrisProofNumberSolver::GetChildNumbers(const MorrisPosition& child, int depth, uint32_t& proofNumber, uint32_t& disproofNumber) const
+	{
+		bool isAttackerWin = false;
+		bool isDecided = false;
+
+		if (child.IsGameOver())
+		{
+			const MorrisGameState attackerWins = (_attacker == MorrisPlayer::Player1) ? MorrisGameState::P1Wins : MorrisGameState::P2Wins;
+			isAttackerWin = child.GetGameState() == attackerWins;
+			isDecided = true;
+		}
+		else if (_path.count(child.GetKey()) > 0 || depth >= _config.maxDepth)
+		{
+			// repetitions and lines that are too deep are not wins for the attacker
+			isDecided = true;
+		}
+
+		if (isDecided)
+		{
+			proofNumber = isAttackerWin ? 0 : Infinity;
+			disproofNumber = isAttackerWin ? Infinity : 0;
+			return;
+		}
+
+		const Entry* entry = Lookup(child.GetKey());
+		proofNumber = entry ? entry->proofNumber : 1;
+		disproofNumber = entry ? entry->disproofNumber : 1;
+	}
+
+	bool MorrisProofNumberSolver::IsBudgetExhausted()
+	{
+		if (_nodes >= _config.maxNodes)
+			_isAborted = true;
+
+		if (_config.timeLimitMilliseconds > 0 && (_nodes & 1023) == 0 && std::chrono::steady_clock::now() >= _deadline)
+			_isAborted = true;
+
+		return _isAborted;
+	}
+
+	std::vector<MorrisMove> MorrisProofNumberSolver::ExtractPrincipalLine(const MorrisPosition& root)
+	{
+		std::vector<MorrisMove> line;
+		std::unordered_set<uint64_t> visited;
+		MorrisPosition position = root;
+		bool isResearched = false;
+
+		while (!position.IsGameOver() && visited.insert(position.GetKey()).second)
+		{
+			MorrisPosition::MoveList moves;
+			const int moveCount = position.GenerateMoves(moves);
+			const bool isOrNode = position.GetSideToMove() == _attacker;
+
+			// the attacker takes the cheapest proven move, the defender the proven reply that took the most work to refute
+			int bestMove = -1;
+			uint32_t bestWork = 0;
+			for (int i = 0; i < moveCount; ++i)
+			{
+				MorrisPosition child = position;
+				child.MakeMove(moves[i]);
+
+				uint32_t work = 0;
+				if (!child.IsGameOver())
+				{
+					const Entry* entry = Lookup(child.GetKey());
+					if (!entry || entry->proofNumber != 0)
+						continue;
+					work = entry->work;
+				}
+				else if (child.GetGameState() != ((_attacker == MorrisPlayer::Player1) ? MorrisGameState::P1Wins : MorrisGameState::P2Wins))
+				{
+					continue;
+				}
+
+				if (bestMove < 0 || (isOrNode ? work < bestWork : work > bestWork))
+				{
+					bestMove = i;
+					bestWork = work;
+				}
+			}
+
+			// the proof of this position was evicted from the table, prove it again and retry
+			if (bestMove < 0)
+			{
+				if (isResearched || _isAborted || !SearchRoot(position))
+					break;
+
+				isResearched = true;
+				visited.erase(position.GetKey());
+				continue;
+			}
+
+			isResearched = false;
+
+			line.push_back(moves[bestMove]);
+			position.MakeMove(moves[bestMove]);
+		}
+		return line;
+	}
+
+	const MorrisProofNumberSolver::Entry* MorrisProofNumberSolver::Lookup(uint64_t key) const
+	{
+		const size_t bucket = GetBucket(key);
+		for (size_t i = bucket; i < bucket + 2; ++i)
+		{
+			if (_table[i].work != 0 && _table[i].key == key)
+				return &_table[i];
+		}
+		return nullptr;
+	}
+
+	void MorrisProofNumberSolver::Store(uint64_t key, uint32_t proofNumber, uint32_t disproofNumber, uint64_t work)
+	{
+		// two entries per bucket, unsolved entries that took less work to compute get replaced first
+		const size_t bucket = GetBucket(key);
+		Entry* slot = &_table[bucket];
+		if (_table[bucket + 1].key == key || (slot->key != key && GetRetentionPriority(_table[bucket + 1]) < GetRetentionPriority(*slot)))
+			slot = &_table[bucket + 1];
+
+		slot->key = key;
+		slot->proofNumber = proofNumber;
+		slot->disproofNumber = disproofNumber;
+		slot->work = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(work, 1), UINT32_MAX));
+	}
+
+	uint64_t MorrisProofNumberSolver::GetRetentionPriority(const Entry& entry)
+	{
+		const bool isSolved = entry.proofNumber == 0 || entry.disproofNumber == 0;
+		return entry.work + (isSolved ? (1ull << 32) : 0);
+	}
+
+	size_t MorrisProofNumberSolver::GetBucket(uint64_t key) const
+	{
+		key ^= key >> 31;
+		key *= 0x7FB5D329728EA185ull;
+		key ^= key >> 27;
+		key *= 0x81DADEF4BC2DD44Dull;
+		key ^= key >> 33;
+		return static_cast<size_t>(key) & (_table.size() - 2);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include <MorrisRandomPlayerAgent.h>
+
+namespace Morris
+{
+	MorrisRandomPlayerAgent::MorrisRandomPlayerAgent(uint32_t seed) :
+		_random(seed)
+	{
+
+	}
+
+	MorrisMove MorrisRandomPlayerAgent::ChooseMove(const MorrisGame& game)
+	{
+		const std::vector<MorrisMove> moves = game.GetLegalMoves();
+		if (moves.empty())
+			return MorrisMove();
+
+		std::uniform_int_distribution<size_t> distribution(0, moves.size() - 1);
+		return moves[distribution(_random)];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <MorrisSnapshot.h>
+#include <thread>
+
+namespace Morris
+{
+	bool MorrisSnapshot::IsOccupied(int pos) const
+	{
+		return ((player1Markers | player2Markers) >> pos) & 1u;
+	}
+
+	bool MorrisSnapshot::GetColorAt(int pos, MorrisPlayer& player) const
+	{
+		if ((player1Markers >> pos) & 1u)
+		{
+			player = MorrisPlayer::Player1;
+			return true;
+		}
+
+		if ((player2Markers >> pos) & 1u)
+		{
+			player = MorrisPlayer::Player2;
+			return true;
+		}
+		return false;
+	}
+
+	int MorrisSnapshot::GetMarkerCount(MorrisPlayer player) const
+	{
+		uint32_t mask = (player == MorrisPlayer::Player1) ? player1Markers : player2Markers;
+		int count = 0;
+		for (; mask; mask &= mask - 1)
+			++count;
+		return count;
+	}
+
+	MorrisSnapshotPublisher::MorrisSnapshotPublisher() :
+		_sequence(0),
+		_boardWord(0),
+		_stateWord(0)
+	{
+
+	}
+
+	void MorrisSnapshotPublisher::Publish(const MorrisSnapshot& snapshot)
+	{
+		const uint64_t boardWord = static_cast<uint64_t>(snapshot.player1Markers) | (static_cast<uint64_t>(snapshot.player2Markers) << 24);
+		const uint64_t stateWord = static_cast<uint64_t>(snapshot.gameState)
+			| (static_cast<uint64_t>(snapshot.currentPlayerTurn) << 8)
+			| (static_cast<uint64_t>(snapshot.unplacedPlayer1Markers) << 16)
+			| (static_cast<uint64_t>(snapshot.unplacedPlayer2Markers) << 24);
+
+		// odd sequence marks a write in progress
+		const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+		_sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		_boardWord.store(boardWord, std::memory_order_relaxed);
+		_stateWord.store(stateWord, std::memory_order_relaxed);
+
+		_sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	MorrisSnapshot MorrisSnapshotPublisher::Read() const
+	{
+		MorrisSnapshot snapshot;
+		while (!TryRead(snapshot))
+			std::this_thread::yield();
+
+		return snapshot;
+	}
+
+	bool MorrisSnapshotPublisher::TryRead(MorrisSnapshot& snapshot) const
+	{
+		const uint32_t sequenceBefore = _sequence.load(std::memory_order_acquire);
+		if (sequenceBefore & 1u)
+			return false;
+
+		const uint64_t boardWord = _boardWord.load(std::memory_order_relaxed);
+		const uint64_t stateWord = _stateWord.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (_sequence.load(std::memory_order_relaxed) != sequenceBefore)
+			return false;
+
+		snapshot.player1Markers = static_cast<uint32_t>(boardWord & 0xFFFFFFu);
+		snapshot.player2Markers = static_cast<uint32_t>((boardWord >> 24) & 0xFFFFFFu);
+		snapshot.gameState = static_cast<MorrisGameState>(stateWord & 0xFFu);
+		snapshot.currentPlayerTurn = static_cast<MorrisPlayer>((stateWord >> 8) & 0xFFu);
+		snapshot.unplacedPlayer1Markers = static_cast<int>((stateWord >> 16) & 0xFFu);
+		snapshot.unplacedPlayer2Markers = static_cast<int>((stateWord >> 24) & 0xFFu);
+		snapshot.version = sequenceBefore / 2;
+		return true;
+	}
+}
\ No newline at end of file
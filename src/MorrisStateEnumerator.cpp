@@ -0,0 +1,178 @@
+#include <MorrisStateEnumerator.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+
+namespace Morris
+{
+	MorrisValueTable::MorrisValueTable(uint64_t size) :
+		_size(size)
+	{
+
+	}
+
+	MorrisValueTable::~MorrisValueTable()
+	{
+		if (!IsSpilled())
+			return;
+
+		_spillFile.close();
+		std::remove(_spillFilePath.c_str());
+	}
+
+	uint64_t MorrisValueTable::GetSize() const
+	{
+		return _size;
+	}
+
+	bool MorrisValueTable::IsSpilled() const
+	{
+		return !_spillFilePath.empty();
+	}
+
+	bool MorrisValueTable::Get(uint64_t index, uint8_t& value) const
+	{
+		return Read(index, 1, &value);
+	}
+
+	bool MorrisValueTable::Read(uint64_t firstIndex, uint64_t count, uint8_t* values) const
+	{
+		if (firstIndex > _size || count > _size - firstIndex)
+			return false;
+
+		if (!IsSpilled())
+		{
+			std::memcpy(values, _values.data() + firstIndex, static_cast<size_t>(count));
+			return true;
+		}
+
+		// a failed read must not leave the stream unusable for the next one
+		std::lock_guard<std::mutex> lock(_spillFileMutex);
+		_spillFile.clear();
+		_spillFile.seekg(static_cast<std::streamoff>(firstIndex));
+		_spillFile.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count));
+		if (_spillFile.gcount() == static_cast<std::streamsize>(count))
+			return true;
+
+		_spillFile.clear();
+		return false;
+	}
+
+	bool MorrisValueTable::Spill(const std::string& directory)
+	{
+		// every table gets a file of its own, "x" makes creation fail instead of reusing a file that already exists
+		static std::atomic<uint32_t> tableCounter(0);
+		std::random_device random;
+		std::string filePath;
+		for (int attempt = 0; attempt < 16 && filePath.empty(); ++attempt)
+		{
+			char fileName[64];
+			std::snprintf(fileName, sizeof(fileName), "morris_values_%08x%08x_%u.bin", random(), random(), tableCounter++);
+
+			const std::string candidate = directory.empty() ? std::string(fileName) : directory + "/" + fileName;
+			if (FILE* file = std::fopen(candidate.c_str(), "wbx"))
+			{
+				std::fclose(file);
+				filePath = candidate;
+			}
+		}
+
+		if (filePath.empty())
+			return false;
+
+		_spillFilePath = filePath;
+		_spillFile.open(filePath, std::ios::in | std::ios::out | std::ios::binary);
+		if (!_spillFile.is_open())
+			return false;
+
+		// writing the last byte gives the file its full size, indices that are never written read as 0
+		if (_size > 0)
+		{
+			_spillFile.seekp(static_cast<std::streamoff>(_size - 1));
+			_spillFile.put(0);
+			_spillFile.flush();
+		}
+		return _spillFile.good();
+	}
+
+	bool MorrisValueTable::Write(uint64_t firstIndex, uint64_t count, const uint8_t* values)
+	{
+		if (!IsSpilled())
+		{
+			std::memcpy(_values.data() + firstIndex, values, static_cast<size_t>(count));
+			return true;
+		}
+
+		// flushing right away surfaces a full disk here rather than in a later read
+		std::lock_guard<std::mutex> lock(_spillFileMutex);
+		_spillFile.seekp(static_cast<std::streamoff>(firstIndex));
+		_spillFile.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count));
+		_spillFile.flush();
+		return _spillFile.good();
+	}
+
+	MorrisStateEnumerator::MorrisStateEnumerator(const MorrisEnumeratorConfig& config) :
+		_config(config)
+	{
+
+	}
+
+	std::unique_ptr<MorrisValueTable> MorrisStateEnumerator::Enumerate(const MorrisPositionIndexer& indexer, const MorrisPositionEvaluator& evaluator) const
+	{
+		const uint64_t size = indexer.GetSize();
+		std::unique_ptr<MorrisValueTable> table(new MorrisValueTable(size));
+		if (size > _config.memoryLimitBytes)
+		{
+			if (!table->Spill(_config.spillDirectory))
+				return nullptr;
+		}
+		else
+		{
+			table->_values.resize(static_cast<size_t>(size), 0);
+		}
+
+		const uint64_t chunkSize = std::max<uint64_t>(_config.chunkSize, 1);
+		const uint64_t chunkCount = (size + chunkSize - 1) / chunkSize;
+		std::atomic<uint64_t> nextChunk(0);
+		std::atomic<bool> writeFailed(false);
+
+		// every thread fills whole chunks, so threads never write to the same part of the table
+		auto worker = [&]()
+		{
+			std::vector<uint8_t> values(static_cast<size_t>(std::min(chunkSize, size)));
+			for (uint64_t chunk = nextChunk++; chunk < chunkCount && !writeFailed; chunk = nextChunk++)
+			{
+				const uint64_t firstIndex = chunk * chunkSize;
+				const uint64_t count = std::min(chunkSize, size - firstIndex);
+				for (uint64_t i = 0; i < count; ++i)
+				{
+					const uint64_t index = firstIndex + i;
+					values[i] = indexer.IsCanonicalIndex(index) ? evaluator(indexer.Unrank(index), index) : 0;
+				}
+				if (!table->Write(firstIndex, count, values.data()))
+					writeFailed = true;
+			}
+		};
+
+		int threadCount = _config.threadCount;
+		if (threadCount <= 0)
+			threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+		threadCount = static_cast<int>(std::min<uint64_t>(threadCount, std::max<uint64_t>(chunkCount, 1)));
+
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; ++i)
+			threads.emplace_back(worker);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// the table removes its spill file when it goes away
+		if (writeFailed)
+			return nullptr;
+
+		return table;
+	}
+}
\ No newline at end of file
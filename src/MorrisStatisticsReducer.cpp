@@ -0,0 +1,78 @@
+#include <MorrisStatisticsReducer.h>
+
+namespace Morris
+{
+	void MorrisStatisticsReducer::OnGameStarted(size_t)
+	{
+		_firstPlacement = -1;
+	}
+
+	void MorrisStatisticsReducer::OnMove(const MorrisPosition&, const MorrisReplayedMove& move, const MorrisPosition&)
+	{
+		if (move.ply == 0 && move.move.type == MorrisMoveType::Place)
+			_firstPlacement = move.move.to;
+
+		_statistics.millsByPhase[static_cast<int>(move.phase)] += move.millsFormed;
+		if (move.move.type == MorrisMoveType::Eliminate)
+		{
+			++_statistics.eliminations;
+			if (move.isAllInMillsElimination)
+				++_statistics.allInMillsEliminations;
+		}
+	}
+
+	void MorrisStatisticsReducer::OnGameFinished(const MorrisPosition&, const MorrisReplayedGame& game)
+	{
+		++_statistics.games;
+		_statistics.plies += game.moveCount;
+		if (!game.isComplete)
+			++_statistics.incompleteGames;
+
+		const bool player1Won = game.result == MorrisGameState::P1Wins;
+		const bool player2Won = game.result == MorrisGameState::P2Wins;
+		if (player1Won)
+			++_statistics.player1Wins;
+		else if (player2Won)
+			++_statistics.player2Wins;
+		else if (game.result == MorrisGameState::Draw)
+			++_statistics.draws;
+		else
+			++_statistics.unfinishedGames;
+
+		if (_firstPlacement >= 0)
+		{
+			++_statistics.gamesByFirstPlacement[_firstPlacement];
+			_statistics.player1WinsByFirstPlacement[_firstPlacement] += player1Won ? 1 : 0;
+			_statistics.player2WinsByFirstPlacement[_firstPlacement] += player2Won ? 1 : 0;
+		}
+	}
+
+	void MorrisStatisticsReducer::Merge(const IMorrisGameReducer& other)
+	{
+		const MorrisGameStatistics& statistics = static_cast<const MorrisStatisticsReducer&>(other)._statistics;
+		_statistics.games += statistics.games;
+		_statistics.incompleteGames += statistics.incompleteGames;
+		_statistics.player1Wins += statistics.player1Wins;
+		_statistics.player2Wins += statistics.player2Wins;
+		_statistics.draws += statistics.draws;
+		_statistics.unfinishedGames += statistics.unfinishedGames;
+		_statistics.plies += statistics.plies;
+		_statistics.eliminations += statistics.eliminations;
+		_statistics.allInMillsEliminations += statistics.allInMillsEliminations;
+
+		for (size_t i = 0; i < _statistics.millsByPhase.size(); ++i)
+			_statistics.millsByPhase[i] += statistics.millsByPhase[i];
+
+		for (int pos = 0; pos < 24; ++pos)
+		{
+			_statistics.gamesByFirstPlacement[pos] += statistics.gamesByFirstPlacement[pos];
+			_statistics.player1WinsByFirstPlacement[pos] += statistics.player1WinsByFirstPlacement[pos];
+			_statistics.player2WinsByFirstPlacement[pos] += statistics.player2WinsByFirstPlacement[pos];
+		}
+	}
+
+	const MorrisGameStatistics& MorrisStatisticsReducer::GetStatistics() const
+	{
+		return _statistics;
+	}
+}
\ No newline at end of file
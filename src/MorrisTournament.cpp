@@ -0,0 +1,240 @@
+#include <MorrisTournament.h>
+#include <MorrisBitboard.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace Morris
+{
+	namespace
+	{
+		bool IsGameOver(MorrisGameState gameState)
+		{
+			return gameState == MorrisGameState::P1Wins || gameState == MorrisGameState::P2Wins || gameState == MorrisGameState::Draw;
+		}
+
+		double EloToScore(double elo)
+		{
+			return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+		}
+
+		double ScoreToElo(double score)
+		{
+			score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+			return -400.0 * std::log10(1.0 / score - 1.0);
+		}
+	}
+
+	MorrisTournament::MorrisTournament(MorrisPlayerAgentFactory firstAgentFactory, MorrisPlayerAgentFactory secondAgentFactory, const MorrisTournamentConfig& config) :
+		_firstAgentFactory(firstAgentFactory),
+		_secondAgentFactory(secondAgentFactory),
+		_config(config)
+	{
+
+	}
+
+	MorrisTournamentResult MorrisTournament::Run()
+	{
+		MorrisTournamentResult result;
+		std::mutex resultMutex;
+		std::atomic<int> nextGameIndex(0);
+		std::atomic<bool> stop(false);
+
+		int threadCount = _config.threadCount;
+		if (threadCount <= 0)
+			threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+		auto worker = [&]()
+		{
+			std::unique_ptr<IMorrisPlayerAgent> firstAgent = _firstAgentFactory();
+			std::unique_ptr<IMorrisPlayerAgent> secondAgent = _secondAgentFactory();
+
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				const int gameIndex = nextGameIndex.fetch_add(1);
+				if (gameIndex >= _config.maxGames)
+					break;
+
+				MorrisGameRecord record = PlayGame(gameIndex, *firstAgent, *secondAgent);
+
+				std::lock_guard<std::mutex> lock(resultMutex);
+				AddGameResult(result, record);
+				if (_config.recordGames)
+					result.games.emplace_back(std::move(record));
+
+				UpdateStatistics(result);
+				if (_config.useSprt && result.sprtDecision != MorrisSprtDecision::None)
+					stop.store(true, std::memory_order_relaxed);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; ++i)
+			threads.emplace_back(worker);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		std::sort(result.games.begin(), result.games.end(), [](const MorrisGameRecord& a, const MorrisGameRecord& b) { return a.gameIndex < b.gameIndex; });
+		return result;
+	}
+
+	std::unique_ptr<MorrisGame> MorrisTournament::ReplayGame(const MorrisGameRecord& record, IMorrisEventListener* listener)
+	{
+		std::unique_ptr<MorrisGame> game(new MorrisGame(listener));
+		game->SetDrawRules(record.drawRules);
+		for (const MorrisMove& move : record.moves)
+		{
+			if (!game->ApplyMove(move))
+				break;
+		}
+		return game;
+	}
+
+	std::vector<std::vector<MorrisMove>> MorrisTournament::GenerateOpenings(int count, int placementsPerOpening, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<std::vector<MorrisMove>> openings;
+		placementsPerOpening = std::min(placementsPerOpening, 18);
+
+		while (static_cast<int>(openings.size()) < count)
+		{
+			std::vector<MorrisMove> opening;
+			uint32_t markers[2] = { 0, 0 };
+			for (int i = 0; i < placementsPerOpening; ++i)
+			{
+				const int player = i % 2;
+				std::vector<int> candidates;
+				for (int pos = 0; pos < 24; ++pos)
+				{
+					const bool isEmpty = ((markers[0] | markers[1]) & MorrisBitboard::Bit(pos)) == 0;
+					if (isEmpty && !MorrisBitboard::FormsMill(markers[player], pos))
+						candidates.push_back(pos);
+				}
+
+				if (candidates.empty())
+					break;
+
+				const int pos = candidates[std::uniform_int_distribution<size_t>(0, candidates.size() - 1)(random)];
+				markers[player] |= MorrisBitboard::Bit(pos);
+				opening.emplace_back(MorrisMove::Placement(static_cast<MorrisPlayer>(player), pos));
+			}
+			openings.emplace_back(std::move(opening));
+		}
+		return openings;
+	}
+
+	MorrisGameRecord MorrisTournament::PlayGame(int gameIndex, IMorrisPlayerAgent& firstAgent, IMorrisPlayerAgent& secondAgent) const
+	{
+		MorrisGameRecord record;
+		record.gameIndex = gameIndex;
+		record.firstAgentIsPlayer1 = (gameIndex % 2) == 0;	// consecutive games share an opening with colors swapped
+		record.drawRules = _config.drawRules;
+
+		MorrisGame game;
+		game.SetDrawRules(_config.drawRules);
+
+		if (!_config.openings.empty())
+		{
+			record.openingIndex = (gameIndex / 2) % static_cast<int>(_config.openings.size());
+			for (const MorrisMove& move : _config.openings[record.openingIndex])
+			{
+				if (!game.ApplyMove(move))
+					break;
+				record.moves.push_back(move);
+			}
+		}
+
+		firstAgent.OnGameStarted(record.firstAgentIsPlayer1 ? MorrisPlayer::Player1 : MorrisPlayer::Player2);
+		secondAgent.OnGameStarted(record.firstAgentIsPlayer1 ? MorrisPlayer::Player2 : MorrisPlayer::Player1);
+
+		while (!IsGameOver(game.GetGameState()))
+		{
+			if (static_cast<int>(record.moves.size()) >= _config.maxPliesPerGame)
+			{
+				record.result = MorrisGameState::Draw;
+				record.adjudicated = true;
+				return record;
+			}
+
+			const MorrisPlayer player = game.GetCurrentPlayerTurn();
+			const bool isFirstAgentTurn = (player == MorrisPlayer::Player1) == record.firstAgentIsPlayer1;
+			const MorrisMove move = isFirstAgentTurn ? firstAgent.ChooseMove(game) : secondAgent.ChooseMove(game);
+
+			// an illegal move forfeits the game
+			if (!game.ApplyMove(move))
+			{
+				record.result = (player == MorrisPlayer::Player1) ? MorrisGameState::P2Wins : MorrisGameState::P1Wins;
+				record.adjudicated = true;
+				return record;
+			}
+			record.moves.push_back(move);
+		}
+
+		record.result = game.GetGameState();
+		return record;
+	}
+
+	void MorrisTournament::AddGameResult(MorrisTournamentResult& result, const MorrisGameRecord& record) const
+	{
+		if (record.result == MorrisGameState::Draw)
+		{
+			++result.draws;
+			return;
+		}
+
+		const bool player1Won = record.result == MorrisGameState::P1Wins;
+		if (player1Won == record.firstAgentIsPlayer1)
+			++result.wins;
+		else
+			++result.losses;
+	}
+
+	void MorrisTournament::UpdateStatistics(MorrisTournamentResult& result) const
+	{
+		const double games = result.wins + result.losses + result.draws;
+		if (games == 0)
+			return;
+
+		result.score = (result.wins + 0.5 * result.draws) / games;
+		result.eloDifference = ScoreToElo(result.score);
+
+		// empty outcome categories count as half a game so the variance can't collapse to zero on one sided results
+		const double wins = result.wins > 0 ? result.wins : 0.5;
+		const double losses = result.losses > 0 ? result.losses : 0.5;
+		const double draws = result.draws > 0 ? result.draws : 0.5;
+		const double n = wins + losses + draws;
+		const double score = (wins + 0.5 * draws) / n;
+		const double variance = (wins * std::pow(1.0 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / n;
+
+		const double margin = 1.959964 * std::sqrt(variance / games);
+		result.eloErrorMargin = (ScoreToElo(result.score + margin) - ScoreToElo(result.score - margin)) / 2.0;
+
+		// trinomial approximation of the log likelihood ratio
+		const double score0 = EloToScore(_config.elo0);
+		const double score1 = EloToScore(_config.elo1);
+		result.llr = games * (score1 - score0) * (2.0 * score - score0 - score1) / (2.0 * variance);
+		result.llrLowerBound = std::log(_config.beta / (1.0 - _config.alpha));
+		result.llrUpperBound = std::log((1.0 - _config.beta) / _config.alpha);
+
+		MorrisSprtDecision decision = MorrisSprtDecision::None;
+		if (result.llr >= result.llrUpperBound)
+			decision = MorrisSprtDecision::AcceptH1;
+		else if (result.llr <= result.llrLowerBound)
+			decision = MorrisSprtDecision::AcceptH0;
+
+		// games that were already running when the test stopped still count, but can't take the decision back
+		if (_config.useSprt && result.sprtDecision != MorrisSprtDecision::None)
+			return;
+
+		result.sprtDecision = decision;
+		if (decision != MorrisSprtDecision::None)
+		{
+			result.llrAtDecision = result.llr;
+			result.gamesAtDecision = result.wins + result.losses + result.draws;
+		}
+	}
+}
\ No newline at end of file